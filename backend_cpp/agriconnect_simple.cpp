@@ -2,16 +2,79 @@
 #include <string>
 #include <iomanip>
 #include <functional>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
 using namespace std;
 
-// Forward declarations for JSON handler
-void saveAllData();
-void loadAllData();
+// JSON persistence and write-ahead log (json_handler.cpp is included at the end)
+#include "json_handler.h"
 
-const int HASH_TABLE_SIZE = 101;
 const int MAX_CITIES = 8;
 const int MAX_HEAP_SIZE = 100;
 
+// Interned strings: fields that repeat a handful of values (roles, qualities,
+// crop types, organizations) hold a Symbol, an index into one global table
+// of distinct strings, so records stay small and comparisons are integer
+// equality. Roles and qualities are interned first, so their symbols are
+// fixed enum values; any other string a file holds still gets its own
+// symbol and is written back unchanged. Symbol 0 is the empty string.
+typedef int Symbol;
+
+enum Role : Symbol {
+    ROLE_FARMER = 1,
+    ROLE_BUYER,
+    ROLE_STORAGE_OWNER,
+    ROLE_TRANSPORT_PROVIDER
+};
+
+enum Quality : Symbol {
+    QUALITY_A = ROLE_TRANSPORT_PROVIDER + 1,
+    QUALITY_B,
+    QUALITY_C
+};
+
+vector<string> symbolNames = { "", "farmer", "buyer", "storage_owner", "transport_provider", "A", "B", "C" };
+unordered_map<string, Symbol> symbolIds = [] {
+    unordered_map<string, Symbol> ids;
+    for (size_t i = 0; i < symbolNames.size(); i++) ids[symbolNames[i]] = (Symbol)i;
+    return ids;
+}();
+shared_mutex symbolLock;  // the loader threads intern concurrently
+
+Symbol intern(const string& s) {
+    {
+        shared_lock<shared_mutex> read(symbolLock);
+        auto it = symbolIds.find(s);
+        if (it != symbolIds.end()) return it->second;
+    }
+    unique_lock<shared_mutex> write(symbolLock);
+    auto it = symbolIds.find(s);
+    if (it != symbolIds.end()) return it->second;
+    Symbol symbol = (Symbol)symbolNames.size();
+    symbolNames.push_back(s);
+    symbolIds[s] = symbol;
+    return symbol;
+}
+
+// Lookup for read paths: a name nobody has stored yet matches nothing, so
+// views answer with NO_SYMBOL instead of growing the table
+const Symbol NO_SYMBOL = -1;
+
+Symbol findSymbol(const string& s) {
+    shared_lock<shared_mutex> read(symbolLock);
+    auto it = symbolIds.find(s);
+    return it != symbolIds.end() ? it->second : NO_SYMBOL;
+}
+
+// Unlocked: names are only read on the main thread, never during a load
+const string& symbolName(Symbol symbol) { return symbolNames[symbol]; }
+
+int symbolCount() { return (int)symbolNames.size(); }
+
 //data structures
 
 struct SimpleDate {
@@ -25,27 +88,24 @@ struct User {
     int userId;
     string username;
     string password;
-    string role;
+    Role role;
     bool active;
-    User* nextInBucket;
     User* nextInList;
 };
 
-// Crop node for BST (sorted by price)
+// Crop node for BST (sorted by price). The fields searches filter on
+// (price, quantity, farmer, type, availability) live in cropStore under row.
 struct Crop {
     int cropId;
-    int farmerId;
-    string cropType;
-    int quantity;
+    int row;
     int storageQuantity;
-    string quality;
-    int pricePerKg;
-    bool available;
+    Quality quality;
     SimpleDate dateAdded;
     SimpleDate expiryDate;
     string storageCenter;
     Crop* left;
     Crop* right;
+    int height;  // AVL subtree height, 1 for a leaf
 };
 
 // Linked list nodes
@@ -62,17 +122,33 @@ struct Order {
     SimpleDate approvalDate;
     SimpleDate paymentDate;
     Order* next;
+    // Chains behind the order indexes, newest first like the list above
+    Order* nextByBuyer;
+    Order* nextByCrop;
+    Order* nextPending;  // the farmer's orders not yet approved
 };
 
+// One crop line of a shipment
+struct TransportLine {
+    int cropId;
+    int quantity;
+    int orderId;  // the order it delivers, 0 for a farmer's own stock or older data
+};
+
+// Most shipments carry 1-4 crop lines, which are stored inline; larger
+// consolidated loads spill to a block from the transport line arena
+const int INLINE_TRANSPORT_LINES = 4;
+
 struct TransportRequest {
     int requestId;
-    int cropIds[50];
-    int quantities[50];
-    int cropCount;
+    int cropCount;                                      // number of crop lines
+    TransportLine inlineLines[INLINE_TRANSPORT_LINES];
+    TransportLine* spilledLines;                        // arena block once cropCount > INLINE_TRANSPORT_LINES
+    int spilledCapacity;
     int weight;
     int distance;
     int budget;
-    string organization;
+    Symbol organization;
     bool accepted;
     bool rejected;
     bool completed;
@@ -91,7 +167,7 @@ struct StorageRequest {
     int quantity;
     int budget;
     int pricePerKg;
-    string organization;
+    Symbol organization;
     bool accepted;
     bool rejected;
     bool released;
@@ -107,12 +183,12 @@ struct Vehicle {
     int capacity;
     bool available;
     string type;
-    string organization;
+    Symbol organization;
     Vehicle* next;
 };
 
 struct StorageCenter {
-    string organization;
+    Symbol organization;
     int totalCapacity;
     int availableCapacity;
     float temperature;
@@ -141,7 +217,6 @@ struct HeapNode {
 };
 
 
-User* userHashTable[HASH_TABLE_SIZE] = { nullptr };
 User* userListHead = nullptr;
 Crop* cropBSTRoot = nullptr;
 Order* orderHead = nullptr;
@@ -156,6 +231,27 @@ int transportReqCount = 0, storageReqCount = 0;
 int vehicleCount = 0, storageCenterCount = 0, cityCount = 0;
 int currentUserId = -1;
 
+// Id allocators, one per entity type. next() is a single fetch_add, so any
+// thread can take an id without a lock, and ids only grow: counts and
+// hashes could hand out an id that was already taken. Nothing is ever
+// deleted, so the highest id in the data is the sequence itself; the
+// insert functions observe() every id they link, which restores each
+// sequence from the snapshot and the WAL on load.
+struct IdAllocator {
+    atomic<int> last{0};
+
+    int next() { return last.fetch_add(1) + 1; }
+
+    void observe(int id) {
+        int seen = last.load();
+        while (seen < id && !last.compare_exchange_weak(seen, id)) {}
+    }
+
+    void reset() { last.store(0); }
+};
+
+IdAllocator userIds, cropIds, orderIds, transportRequestIds, storageRequestIds, vehicleIds;
+
 
 int maxInt(int a, int b) { return (a > b) ? a : b; }
 
@@ -187,155 +283,814 @@ string formatDate(SimpleDate d) {
     return twoDigit(d.day) + "-" + twoDigit(d.month) + "-" + to_string(d.year);
 }
 
-int hashUsername(string username) {
-    int h = 0;
-    for (int i = 0; i < username.length(); i++)
-        h = (h * 31 + username[i]) % HASH_TABLE_SIZE;
+// FNV-1a: mixes every byte into all 32 bits, unlike the old modulo-101 rolling hash
+unsigned int hashUsername(const string& username) {
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < username.length(); i++) {
+        h ^= (unsigned char)username[i];
+        h *= 16777619u;
+    }
     return h;
 }
 
-int hashID(string key) {
-    int h = 0;
-    for (int i = 0; i < key.length(); i++)
-        h = (h * 31 + key[i]) % 100000;
-    return h;
+// Crop store: the crop fields marketplace searches filter on sit in
+// parallel columns indexed by a crop's row instead of in the Crop node, so
+// a filter streams through a few contiguous arrays rather than whole nodes
+// (strings, dates, tree links). Rows follow creation order. The price tree
+// and the id index still point at nodes; record maps a row back to its
+// node. byPrice lists the rows linked into the price tree in its in-order
+// sequence, so listings scan the columns in price order without touching
+// nodes or sorting. Unlocked like the node pools: only the crop loader
+// thread creates crops during a load.
+struct CropStore {
+    vector<int> pricePerKg;
+    vector<int> quantity;
+    vector<int> farmerId;
+    vector<Symbol> cropType;
+    vector<char> available;
+    vector<Crop*> record;  // nullptr once the row's crop is deleted
+    vector<int> byPrice;   // linked rows only, cheapest first
+};
+
+CropStore cropStore;
+
+int& cropPrice(Crop* crop) { return cropStore.pricePerKg[crop->row]; }
+int& cropQuantity(Crop* crop) { return cropStore.quantity[crop->row]; }
+int& cropFarmerId(Crop* crop) { return cropStore.farmerId[crop->row]; }
+Symbol& cropType(Crop* crop) { return cropStore.cropType[crop->row]; }
+char& cropAvailable(Crop* crop) { return cropStore.available[crop->row]; }
+
+int cropRows() { return (int)cropStore.record.size(); }
+
+// newNode()/deleteNode() hooks; only crops keep anything outside the node
+template <typename T> void attachNode(T*) {}
+template <typename T> void detachNode(T*) {}
+
+void attachNode(Crop* crop) {
+    crop->row = cropRows();
+    cropStore.pricePerKg.push_back(0);
+    cropStore.quantity.push_back(0);
+    cropStore.farmerId.push_back(0);
+    cropStore.cropType.push_back(0);
+    cropStore.available.push_back(0);
+    cropStore.record.push_back(crop);
+}
+
+// Only the newest crop is ever deleted (a half-read or replayed record), so
+// its row is dropped; any other row is just marked dead
+void detachNode(Crop* crop) {
+    if (crop->row + 1 == cropRows()) {
+        cropStore.pricePerKg.pop_back();
+        cropStore.quantity.pop_back();
+        cropStore.farmerId.pop_back();
+        cropStore.cropType.pop_back();
+        cropStore.available.pop_back();
+        cropStore.record.pop_back();
+        return;
+    }
+    cropStore.available[crop->row] = 0;
+    cropStore.record[crop->row] = nullptr;
+}
+
+// Copy the row fields as well as the node, keeping to's own row
+void copyCrop(Crop* to, Crop* from) {
+    int row = to->row;
+    *to = *from;
+    to->row = row;
+    cropPrice(to) = cropPrice(from);
+    cropQuantity(to) = cropQuantity(from);
+    cropFarmerId(to) = cropFarmerId(from);
+    cropType(to) = cropType(from);
+    cropAvailable(to) = cropAvailable(from);
+}
+
+// Node pools: every node type is carved out of its own 64 KB slabs instead
+// of a bare new per node. Nodes created together sit next to each other, so
+// list scans walk contiguous memory, and a load makes one allocation per
+// slab rather than one per node. deleteNode() resets a node and keeps it on
+// a free list for the next newNode(); releaseNodePool() destroys them all at
+// once. Pools are not locked: a node type may only be allocated by one
+// thread at a time (loading gives each collection its own thread).
+const size_t NODE_SLAB_BYTES = 64 * 1024;
+
+template <typename T>
+struct NodePool {
+    vector<T*> slabs;
+    size_t usedInLastSlab = 0;
+    vector<T*> freeList;
+};
+
+template <typename T>
+NodePool<T> nodePool;
+
+struct NodePoolStats {
+    long long live;
+    long long free;
+    long long slabs;
+    long long bytes;
+};
+
+template <typename T>
+size_t nodesPerSlab() {
+    return max<size_t>(1, NODE_SLAB_BYTES / sizeof(T));
+}
+
+// A value-initialized node (zeroed numbers and links, empty strings)
+template <typename T>
+T* newNode() {
+    NodePool<T>& pool = nodePool<T>;
+    if (!pool.freeList.empty()) {
+        T* node = pool.freeList.back();  // already reset by deleteNode
+        pool.freeList.pop_back();
+        attachNode(node);
+        return node;
+    }
+    if (pool.slabs.empty() || pool.usedInLastSlab == nodesPerSlab<T>()) {
+        pool.slabs.push_back(static_cast<T*>(::operator new(nodesPerSlab<T>() * sizeof(T))));
+        pool.usedInLastSlab = 0;
+    }
+    T* node = new (pool.slabs.back() + pool.usedInLastSlab++) T();
+    attachNode(node);
+    return node;
+}
+
+template <typename T>
+void deleteNode(T* node) {
+    detachNode(node);
+    *node = T();  // releases the node's strings now rather than on reuse
+    nodePool<T>.freeList.push_back(node);
+}
+
+template <typename T>
+void releaseNodePool() {
+    NodePool<T>& pool = nodePool<T>;
+    for (size_t s = 0; s < pool.slabs.size(); s++) {
+        size_t used = (s + 1 == pool.slabs.size()) ? pool.usedInLastSlab : nodesPerSlab<T>();
+        for (size_t i = 0; i < used; i++) pool.slabs[s][i].~T();
+        ::operator delete(pool.slabs[s]);
+    }
+    pool.slabs.clear();
+    pool.usedInLastSlab = 0;
+    pool.freeList.clear();
+}
+
+template <typename T>
+void addNodePoolStats(NodePoolStats& stats) {
+    const NodePool<T>& pool = nodePool<T>;
+    long long constructed = pool.slabs.empty() ? 0 : (long long)((pool.slabs.size() - 1) * nodesPerSlab<T>() + pool.usedInLastSlab);
+    stats.live += constructed - (long long)pool.freeList.size();
+    stats.free += (long long)pool.freeList.size();
+    stats.slabs += (long long)pool.slabs.size();
+    stats.bytes += (long long)(pool.slabs.size() * nodesPerSlab<T>() * sizeof(T));
+}
+
+NodePoolStats getNodePoolStats() {
+    NodePoolStats stats = { 0, 0, 0, 0 };
+    addNodePoolStats<User>(stats);
+    addNodePoolStats<Crop>(stats);
+    addNodePoolStats<Order>(stats);
+    addNodePoolStats<TransportRequest>(stats);
+    addNodePoolStats<StorageRequest>(stats);
+    addNodePoolStats<Vehicle>(stats);
+    addNodePoolStats<StorageCenter>(stats);
+    addNodePoolStats<EdgeNode>(stats);
+    return stats;
+}
+
+// Transport line arena: spilled crop-line blocks are bump-allocated from
+// 64 KB chunks and only ever freed all together (with the transport pool).
+// A block outgrown by its request is simply left behind.
+struct TransportLineArena {
+    vector<TransportLine*> chunks;
+    size_t usedInLastChunk = 0;
+    size_t lastChunkCapacity = 0;
+};
+
+TransportLineArena transportLineArena;
+
+TransportLine* allocateTransportLines(int count) {
+    TransportLineArena& arena = transportLineArena;
+    if (arena.chunks.empty() || arena.usedInLastChunk + count > arena.lastChunkCapacity) {
+        size_t capacity = max<size_t>(NODE_SLAB_BYTES / sizeof(TransportLine), (size_t)count);
+        arena.chunks.push_back(new TransportLine[capacity]);
+        arena.usedInLastChunk = 0;
+        arena.lastChunkCapacity = capacity;
+    }
+    TransportLine* block = arena.chunks.back() + arena.usedInLastChunk;
+    arena.usedInLastChunk += count;
+    return block;
+}
+
+void releaseTransportLines() {
+    for (size_t i = 0; i < transportLineArena.chunks.size(); i++) delete[] transportLineArena.chunks[i];
+    transportLineArena = TransportLineArena();
+}
+
+TransportLine* transportLines(TransportRequest* req) {
+    return req->spilledLines != nullptr ? req->spilledLines : req->inlineLines;
+}
+
+void addTransportLine(TransportRequest* req, int cropId, int quantity, int orderId) {
+    if (req->cropCount == INLINE_TRANSPORT_LINES && req->spilledLines == nullptr) {
+        req->spilledCapacity = INLINE_TRANSPORT_LINES * 4;
+        req->spilledLines = allocateTransportLines(req->spilledCapacity);
+        copy(req->inlineLines, req->inlineLines + INLINE_TRANSPORT_LINES, req->spilledLines);
+    } else if (req->spilledLines != nullptr && req->cropCount == req->spilledCapacity) {
+        TransportLine* grown = allocateTransportLines(req->spilledCapacity * 2);
+        copy(req->spilledLines, req->spilledLines + req->cropCount, grown);
+        req->spilledLines = grown;
+        req->spilledCapacity *= 2;
+    }
+    transportLines(req)[req->cropCount++] = { cropId, quantity, orderId };
+}
+
+// Id index: open addressing with linear probing over a power-of-two table.
+// Ids are small, mostly sequential ints, so a multiplicative hash spreads
+// them before masking. The table doubles at 70% load, keeping lookups O(1).
+template <typename T>
+struct IdIndex {
+    struct Slot { int key; T* value; };
+    vector<Slot> slots;  // value == nullptr marks an empty slot
+    int count = 0;
+};
+
+inline unsigned int idSlot(int key, size_t mask) {
+    return (unsigned int)(((unsigned int)key * 2654435761u) & mask);
+}
+
+template <typename T>
+void idIndexGrow(IdIndex<T>& index) {
+    vector<typename IdIndex<T>::Slot> old;
+    old.swap(index.slots);
+    index.slots.assign(old.empty() ? 64 : old.size() * 2, { 0, nullptr });
+    size_t mask = index.slots.size() - 1;
+    for (size_t i = 0; i < old.size(); i++) {
+        if (old[i].value == nullptr) continue;
+        size_t pos = idSlot(old[i].key, mask);
+        while (index.slots[pos].value != nullptr) pos = (pos + 1) & mask;
+        index.slots[pos] = old[i];
+    }
+}
+
+// Insert or replace: the newest entry wins, as the old head-inserted list walk did
+template <typename T>
+void idIndexPut(IdIndex<T>& index, int key, T* value) {
+    if ((index.count + 1) * 10 > (int)index.slots.size() * 7) idIndexGrow(index);
+    size_t mask = index.slots.size() - 1;
+    size_t pos = idSlot(key, mask);
+    while (index.slots[pos].value != nullptr) {
+        if (index.slots[pos].key == key) {
+            index.slots[pos].value = value;
+            return;
+        }
+        pos = (pos + 1) & mask;
+    }
+    index.slots[pos] = { key, value };
+    index.count++;
+}
+
+// Grow once up front for a bulk load instead of doubling along the way
+template <typename T>
+void idIndexReserve(IdIndex<T>& index, int count) {
+    while (count * 10 > (int)index.slots.size() * 7) idIndexGrow(index);
+}
+
+template <typename T>
+T* idIndexGet(const IdIndex<T>& index, int key) {
+    if (index.slots.empty()) return nullptr;
+    size_t mask = index.slots.size() - 1;
+    size_t pos = idSlot(key, mask);
+    while (index.slots[pos].value != nullptr) {
+        if (index.slots[pos].key == key) return index.slots[pos].value;
+        pos = (pos + 1) & mask;
+    }
+    return nullptr;
+}
+
+// Backward-shift delete: later entries of the probe run move up into the
+// hole, so no lookup can stop early at it and no tombstones pile up
+template <typename T>
+void idIndexErase(IdIndex<T>& index, int key) {
+    if (index.slots.empty()) return;
+    size_t mask = index.slots.size() - 1;
+    size_t hole = idSlot(key, mask);
+    while (index.slots[hole].value != nullptr && index.slots[hole].key != key) hole = (hole + 1) & mask;
+    if (index.slots[hole].value == nullptr) return;
+    for (size_t pos = (hole + 1) & mask; index.slots[pos].value != nullptr; pos = (pos + 1) & mask) {
+        size_t home = idSlot(index.slots[pos].key, mask);
+        // Movable when the hole lies between its home slot and where it sits
+        if (((pos - home) & mask) >= ((pos - hole) & mask)) {
+            index.slots[hole] = index.slots[pos];
+            hole = pos;
+        }
+    }
+    index.slots[hole] = { 0, nullptr };
+    index.count--;
+}
+
+IdIndex<User> userIdIndex;
+IdIndex<Crop> cropIdIndex;
+
+// Username table: Robin Hood open addressing. Each slot keeps the full hash
+// and its distance from the home slot; an insert that has probed further
+// than the resident takes its place, so probe lengths stay short and a miss
+// can stop as soon as it sees a slot closer to home than itself. The table
+// doubles at 80% load, so lookups stay O(1) however many users register.
+struct UserSlot {
+    unsigned int hash;
+    unsigned int dist;   // probe distance from hash & mask
+    User* user;          // nullptr marks an empty slot
+};
+
+struct UserTable {
+    vector<UserSlot> slots;
+    int count = 0;
+    long long totalProbe = 0;  // sum of slot distances, kept as entries move
+    int maxProbe = 0;          // distances only grow until the next rehash
+};
+
+struct UserTableStats {
+    int count;
+    int capacity;
+    double loadFactor;
+    double avgProbe;
+    int maxProbe;
+};
+
+UserTable userTable;
+
+void userTablePlace(UserTable& table, UserSlot entry) {
+    size_t mask = table.slots.size() - 1;
+    size_t pos = entry.hash & mask;
+    entry.dist = 0;
+    while (true) {
+        UserSlot& slot = table.slots[pos];
+        if (slot.user == nullptr) {
+            slot = entry;
+            table.maxProbe = max(table.maxProbe, (int)entry.dist);
+            return;
+        }
+        if (slot.dist < entry.dist) {
+            swap(slot, entry);
+            table.maxProbe = max(table.maxProbe, (int)slot.dist);
+        }
+        pos = (pos + 1) & mask;
+        entry.dist++;
+        table.totalProbe++;  // a swap keeps the sum, each step adds one
+    }
+}
+
+void userTableGrow(UserTable& table) {
+    vector<UserSlot> old;
+    old.swap(table.slots);
+    table.slots.assign(old.empty() ? 16 : old.size() * 2, { 0, 0, nullptr });
+    table.totalProbe = 0;
+    table.maxProbe = 0;
+    for (size_t i = 0; i < old.size(); i++) {
+        if (old[i].user != nullptr) userTablePlace(table, old[i]);
+    }
+}
+
+UserSlot* userTableFind(UserTable& table, unsigned int hash, const string& username) {
+    if (table.slots.empty()) return nullptr;
+    size_t mask = table.slots.size() - 1;
+    size_t pos = hash & mask;
+    for (unsigned int dist = 0; ; dist++) {
+        UserSlot& slot = table.slots[pos];
+        if (slot.user == nullptr || slot.dist < dist) return nullptr;
+        if (slot.hash == hash && slot.user->username == username) return &slot;
+        pos = (pos + 1) & mask;
+    }
+}
+
+// O(1): the probe totals are maintained by userTablePlace
+UserTableStats getUserTableStats() {
+    UserTableStats stats = { userTable.count, (int)userTable.slots.size(), 0.0, 0.0, userTable.maxProbe };
+    if (stats.capacity > 0) stats.loadFactor = (double)stats.count / stats.capacity;
+    if (stats.count > 0) stats.avgProbe = (double)userTable.totalProbe / stats.count;
+    return stats;
 }
 
 //hash table
 
+// Size the username table and id index for `expected` more users (bulk loads)
+void reserveUsers(int expected) {
+    while ((userTable.count + expected) * 10 > (int)userTable.slots.size() * 8) userTableGrow(userTable);
+    idIndexReserve(userIdIndex, userIdIndex.count + expected);
+}
+
 void insertUser(User* newUser) {
-    int idx = hashUsername(newUser->username);
-    newUser->nextInBucket = userHashTable[idx];
-    userHashTable[idx] = newUser;
+    unsigned int hash = hashUsername(newUser->username);
+    UserSlot* existing = userTableFind(userTable, hash, newUser->username);
+    if (existing != nullptr) {
+        existing->user = newUser;  // newest registration wins, as with the old chain head
+    } else {
+        if ((userTable.count + 1) * 10 > (int)userTable.slots.size() * 8) userTableGrow(userTable);
+        userTablePlace(userTable, { hash, 0, newUser });
+        userTable.count++;
+    }
 
     newUser->nextInList = userListHead;
     userListHead = newUser;
+    idIndexPut(userIdIndex, newUser->userId, newUser);
+    userIds.observe(newUser->userId);
     userCount++;
+    markDirty(DATA_USERS);
 }
 
 User* findUserByUsername(string username) {
-    int idx = hashUsername(username);
-    User* curr = userHashTable[idx];
-    while (curr != nullptr) {
-        if (curr->username == username) return curr;
-        curr = curr->nextInBucket;
-    }
-    return nullptr;
+    UserSlot* slot = userTableFind(userTable, hashUsername(username), username);
+    return (slot != nullptr) ? slot->user : nullptr;
 }
 
 User* findUserById(int userId) {
-    User* curr = userListHead;
-    while (curr != nullptr) {
-        if (curr->userId == userId) return curr;
-        curr = curr->nextInList;
-    }
-    return nullptr;
+    return idIndexGet(userIdIndex, userId);
 }
 
 //BST
 
-Crop* insertCropBST(Crop* root, Crop* newCrop) {
-    if (root == nullptr) return newCrop;
+// AVL-balanced price index: equal prices go right, and rotations keep the
+// in-order sequence, so listings stay sorted by price (ties in insertion
+// order) while the height stays O(log n) even for price-sorted input.
+int cropHeight(Crop* node) {
+    return (node == nullptr) ? 0 : node->height;
+}
+
+void updateCropHeight(Crop* node) {
+    int lh = cropHeight(node->left), rh = cropHeight(node->right);
+    node->height = 1 + ((lh > rh) ? lh : rh);
+}
+
+Crop* rotateCropRight(Crop* node) {
+    Crop* pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    updateCropHeight(node);
+    updateCropHeight(pivot);
+    return pivot;
+}
+
+Crop* rotateCropLeft(Crop* node) {
+    Crop* pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    updateCropHeight(node);
+    updateCropHeight(pivot);
+    return pivot;
+}
 
-    if (newCrop->pricePerKg < root->pricePerKg)
+Crop* rebalanceCrop(Crop* node) {
+    updateCropHeight(node);
+    int balance = cropHeight(node->left) - cropHeight(node->right);
+    if (balance > 1) {
+        if (cropHeight(node->left->left) < cropHeight(node->left->right))
+            node->left = rotateCropLeft(node->left);
+        return rotateCropRight(node);
+    }
+    if (balance < -1) {
+        if (cropHeight(node->right->right) < cropHeight(node->right->left))
+            node->right = rotateCropRight(node->right);
+        return rotateCropLeft(node);
+    }
+    return node;
+}
+
+Crop* insertCropBST(Crop* root, Crop* newCrop) {
+    if (root == nullptr) {
+        newCrop->left = newCrop->right = nullptr;
+        newCrop->height = 1;
+        return newCrop;
+    }
+    if (cropPrice(newCrop) < cropPrice(root))
         root->left = insertCropBST(root->left, newCrop);
     else
         root->right = insertCropBST(root->right, newCrop);
+    return rebalanceCrop(root);
+}
 
-    return root;
+// Equal prices go right in the tree, so a new row follows every row of its
+// price; one memmove of the row list per interactive insert
+void linkCropRow(Crop* crop) {
+    vector<int>& rows = cropStore.byPrice;
+    auto at = upper_bound(rows.begin(), rows.end(), cropPrice(crop),
+                          [](int price, int row) { return price < cropStore.pricePerKg[row]; });
+    rows.insert(at, crop->row);
 }
 
-void inOrderTraversal(Crop* root) {
-    if (root == nullptr) return;
-    inOrderTraversal(root->left);
-    if (root->available) {
-        User* farmer = findUserById(root->farmerId);
+// Add a crop to the price BST, the price-ordered rows and the id index
+// together so they never drift
+void insertCrop(Crop* newCrop) {
+    cropBSTRoot = insertCropBST(cropBSTRoot, newCrop);
+    linkCropRow(newCrop);
+    idIndexPut(cropIdIndex, newCrop->cropId, newCrop);
+    cropIds.observe(newCrop->cropId);
+    cropCount++;
+    markDirty(DATA_CROPS);
+}
+
+// Build a perfectly balanced tree from crops[lo, hi) already sorted by price
+Crop* buildCropTree(vector<Crop*>& crops, int lo, int hi) {
+    if (lo >= hi) return nullptr;
+    int mid = lo + (hi - lo) / 2;
+    Crop* node = crops[mid];
+    node->left = buildCropTree(crops, lo, mid);
+    node->right = buildCropTree(crops, mid + 1, hi);
+    updateCropHeight(node);
+    return node;
+}
+
+// Add a whole batch (e.g. a reload) at once: O(n log n) and no rebalancing
+// when the tree starts empty, otherwise one AVL insert per crop
+void insertCrops(vector<Crop*>& crops) {
+    auto byPrice = [](Crop* a, Crop* b) { return cropPrice(a) < cropPrice(b); };
+    if (cropBSTRoot != nullptr) {
+        // One merge into the row order instead of a shifting insert per crop;
+        // the merge is stable, so existing rows stay ahead of equal new ones
+        vector<int>& rows = cropStore.byPrice;
+        size_t linked = rows.size();
+        stable_sort(crops.begin(), crops.end(), byPrice);
+        for (size_t i = 0; i < crops.size(); i++) {
+            cropBSTRoot = insertCropBST(cropBSTRoot, crops[i]);
+            rows.push_back(crops[i]->row);
+            idIndexPut(cropIdIndex, crops[i]->cropId, crops[i]);
+            cropIds.observe(crops[i]->cropId);
+        }
+        inplace_merge(rows.begin(), rows.begin() + linked, rows.end(),
+                      [](int a, int b) { return cropStore.pricePerKg[a] < cropStore.pricePerKg[b]; });
+        cropCount += (int)crops.size();
+        markDirty(DATA_CROPS);
+        return;
+    }
+    // Files are saved in price order, so this is normally skipped; stable keeps tie order
+    if (!is_sorted(crops.begin(), crops.end(), byPrice)) stable_sort(crops.begin(), crops.end(), byPrice);
+    cropBSTRoot = buildCropTree(crops, 0, (int)crops.size());
+    cropStore.byPrice.reserve(crops.size());
+    idIndexReserve(cropIdIndex, cropIdIndex.count + (int)crops.size());
+    for (size_t i = 0; i < crops.size(); i++) {
+        cropStore.byPrice.push_back(crops[i]->row);
+        idIndexPut(cropIdIndex, crops[i]->cropId, crops[i]);
+        cropIds.observe(crops[i]->cropId);
+    }
+    cropCount += (int)crops.size();
+    markDirty(DATA_CROPS);
+}
+
+// Rows whose columns pass keep(row), in the price tree's in-order sequence.
+// A column scan over the linked rows: crops created but never inserted are
+// not listed, and no node is touched until the caller prints one.
+template <typename Keep>
+vector<int> selectCropRows(Keep keep) {
+    vector<int> rows;
+    const vector<int>& linked = cropStore.byPrice;
+    for (size_t i = 0; i < linked.size(); i++) {
+        if (keep(linked[i])) rows.push_back(linked[i]);
+    }
+    return rows;
+}
+
+void printAvailableCrops() {
+    vector<int> rows = selectCropRows([](int row) { return cropStore.available[row] != 0; });
+    for (size_t i = 0; i < rows.size(); i++) {
+        Crop* crop = cropStore.record[rows[i]];
+        User* farmer = findUserById(cropFarmerId(crop));
         string farmerName = (farmer != nullptr) ? farmer->username : "Unknown";
-        cout << setw(8) << root->cropId << setw(12) << root->cropType
-            << setw(8) << root->quality << setw(10) << root->pricePerKg
-            << setw(12) << root->quantity << setw(15) << farmerName << "\n";
+        cout << setw(8) << crop->cropId << setw(12) << symbolName(cropType(crop))
+            << setw(8) << symbolName(crop->quality) << setw(10) << cropPrice(crop)
+            << setw(12) << cropQuantity(crop) << setw(15) << farmerName << "\n";
     }
-    inOrderTraversal(root->right);
 }
 
-Crop* findCropById(Crop* root, int cropId) {
-    if (root == nullptr) return nullptr;
-    if (root->cropId == cropId) return root;
-
-    Crop* left = findCropById(root->left, cropId);
-    if (left != nullptr) return left;
-    return findCropById(root->right, cropId);
+// O(1) through the id index; the BST is ordered by price, not id
+Crop* findCropById(int cropId) {
+    return idIndexGet(cropIdIndex, cropId);
 }
 
-int countCropsForFarmer(Crop* root, int farmerId) {
-    if (root == nullptr) return 0;
-    int left = countCropsForFarmer(root->left, farmerId);
-    int self = (root->farmerId == farmerId) ? 1 : 0;
-    int right = countCropsForFarmer(root->right, farmerId);
-    return left + self + right;
+int countCropsForFarmer(int farmerId) {
+    int count = 0;
+    const vector<int>& linked = cropStore.byPrice;
+    for (size_t i = 0; i < linked.size(); i++) {
+        if (cropStore.farmerId[linked[i]] == farmerId) count++;
+    }
+    return count;
 }
 
-void printFarmerCrops(Crop* root, int farmerId) {
-    if (root == nullptr) return;
-    printFarmerCrops(root->left, farmerId);
-    if (root->farmerId == farmerId) {
-        cout << root->cropId << "\t" << root->cropType << "\t"
-            << root->quantity << "\t\t" << root->quality << "\t"
-            << root->pricePerKg << "\t" << formatDate(root->dateAdded) << "\n";
+void printFarmerCrops(int farmerId) {
+    vector<int> rows = selectCropRows([farmerId](int row) { return cropStore.farmerId[row] == farmerId; });
+    for (size_t i = 0; i < rows.size(); i++) {
+        Crop* crop = cropStore.record[rows[i]];
+        cout << crop->cropId << "\t" << symbolName(cropType(crop)) << "\t"
+            << cropQuantity(crop) << "\t\t" << symbolName(crop->quality) << "\t"
+            << cropPrice(crop) << "\t" << formatDate(crop->dateAdded) << "\n";
     }
-    printFarmerCrops(root->right, farmerId);
 }
 
-void printCropsByTypeAndBudget(Crop* root, const string& targetCrop, int maxBudget, bool& found) {
-    if (root == nullptr) return;
-    printCropsByTypeAndBudget(root->left, targetCrop, maxBudget, found);
-    if (root->available && toLower(root->cropType) == toLower(targetCrop) && root->pricePerKg <= maxBudget) {
+// typeMatches[s] says whether crop type symbol s matches the search
+void printCropsByTypeAndBudget(const vector<bool>& typeMatches, int maxBudget, bool& found) {
+    vector<int> rows = selectCropRows([&typeMatches, maxBudget](int row) {
+        return cropStore.available[row] != 0 && cropStore.pricePerKg[row] <= maxBudget &&
+               typeMatches[cropStore.cropType[row]];
+    });
+    for (size_t i = 0; i < rows.size(); i++) {
+        Crop* crop = cropStore.record[rows[i]];
         found = true;
-        User* farmer = findUserById(root->farmerId);
+        User* farmer = findUserById(cropFarmerId(crop));
         string farmerName = (farmer != nullptr) ? farmer->username : "Unknown";
-        cout << setw(8) << root->cropId << setw(8) << root->quality
-            << setw(10) << root->pricePerKg << setw(12) << root->quantity
+        cout << setw(8) << crop->cropId << setw(8) << symbolName(crop->quality)
+            << setw(10) << cropPrice(crop) << setw(12) << cropQuantity(crop)
             << setw(15) << farmerName << "\n";
     }
-    printCropsByTypeAndBudget(root->right, targetCrop, maxBudget, found);
 }
 
 //linked list
 
+// Order indexes: orderId -> order, and buyerId, cropId and farmerId to the
+// head of a chain threaded through the orders themselves (nextByBuyer,
+// nextByCrop, nextPending), so a per-user view walks only that user's k
+// orders instead of every order. Chains are head-inserted like orderHead
+// and keep its order. The pending chain holds only orders the farmer has
+// not approved; approveOrder() unlinks from it.
+IdIndex<Order> orderIdIndex;
+IdIndex<Order> buyerOrders;
+IdIndex<Order> cropOrders;
+IdIndex<Order> pendingFarmerOrders;
+
+void reserveOrders(int expected) {
+    idIndexReserve(orderIdIndex, orderIdIndex.count + expected);
+}
+
+Order* findOrderById(int orderId) {
+    return idIndexGet(orderIdIndex, orderId);
+}
+
+Order* ordersForBuyer(int buyerId) {
+    return idIndexGet(buyerOrders, buyerId);
+}
+
+Order* ordersForCrop(int cropId) {
+    return idIndexGet(cropOrders, cropId);
+}
+
+Order* pendingOrdersForFarmer(int farmerId) {
+    return idIndexGet(pendingFarmerOrders, farmerId);
+}
+
+void linkPendingOrder(Order* order) {
+    order->nextPending = pendingOrdersForFarmer(order->farmerId);
+    idIndexPut(pendingFarmerOrders, order->farmerId, order);
+}
+
+void unlinkPendingOrder(Order* order) {
+    Order* head = pendingOrdersForFarmer(order->farmerId);
+    if (head == order) {
+        if (order->nextPending != nullptr) idIndexPut(pendingFarmerOrders, order->farmerId, order->nextPending);
+        else idIndexErase(pendingFarmerOrders, order->farmerId);
+    } else {
+        Order* prev = head;
+        while (prev != nullptr && prev->nextPending != order) prev = prev->nextPending;
+        if (prev != nullptr) prev->nextPending = order->nextPending;
+    }
+    order->nextPending = nullptr;
+}
+
 void addOrder(Order* newOrder) {
     newOrder->next = orderHead;
     orderHead = newOrder;
+    newOrder->nextByBuyer = ordersForBuyer(newOrder->buyerId);
+    idIndexPut(buyerOrders, newOrder->buyerId, newOrder);
+    newOrder->nextByCrop = ordersForCrop(newOrder->cropId);
+    idIndexPut(cropOrders, newOrder->cropId, newOrder);
+    if (!newOrder->farmerApproved) linkPendingOrder(newOrder);
+    idIndexPut(orderIdIndex, newOrder->orderId, newOrder);
+    orderIds.observe(newOrder->orderId);
     orderCount++;
+    markDirty(DATA_ORDERS);
+}
+
+void approveOrder(Order* order) {
+    order->farmerApproved = true;
+    order->approvalDate = getCurrentDate();
+    unlinkPendingOrder(order);
+}
+
+// Copy a replayed order over the live one, keeping its list and chain
+// links; buyer, farmer and crop never change, only the status can
+void replaceOrder(Order* to, Order* from) {
+    bool wasPending = !to->farmerApproved;
+    Order* next = to->next;
+    Order* nextByBuyer = to->nextByBuyer;
+    Order* nextByCrop = to->nextByCrop;
+    Order* nextPending = to->nextPending;
+    *to = *from;
+    to->next = next;
+    to->nextByBuyer = nextByBuyer;
+    to->nextByCrop = nextByCrop;
+    to->nextPending = nextPending;
+    if (wasPending && to->farmerApproved) unlinkPendingOrder(to);
+}
+
+IdIndex<TransportRequest> transportIdIndex;
+
+TransportRequest* findTransportRequestById(int requestId) {
+    return idIndexGet(transportIdIndex, requestId);
 }
 
 void addTransportRequest(TransportRequest* req) {
     req->next = transportHead;
     transportHead = req;
+    idIndexPut(transportIdIndex, req->requestId, req);
+    transportRequestIds.observe(req->requestId);
     transportReqCount++;
+    markDirty(DATA_TRANSPORT_REQUESTS);
+}
+
+// Storage requests and vehicles by id, storage centers by organization; the
+// newest entry wins, as the head-inserted list walks found it first
+IdIndex<StorageRequest> storageIdIndex;
+IdIndex<Vehicle> vehicleIdIndex;
+IdIndex<StorageCenter> storageCenterIndex;
+
+StorageRequest* findStorageRequestById(int requestId) {
+    return idIndexGet(storageIdIndex, requestId);
+}
+
+Vehicle* findVehicleById(int vehicleId) {
+    return idIndexGet(vehicleIdIndex, vehicleId);
+}
+
+StorageCenter* findStorageCenter(Symbol organization) {
+    return idIndexGet(storageCenterIndex, organization);
 }
 
 void addStorageRequest(StorageRequest* req) {
     req->next = storageHead;
     storageHead = req;
+    idIndexPut(storageIdIndex, req->requestId, req);
+    storageRequestIds.observe(req->requestId);
     storageReqCount++;
+    markDirty(DATA_STORAGE_REQUESTS);
 }
 
 void addVehicle(Vehicle* v) {
     v->next = vehicleHead;
     vehicleHead = v;
+    idIndexPut(vehicleIdIndex, v->vehicleId, v);
+    vehicleIds.observe(v->vehicleId);
     vehicleCount++;
+    markDirty(DATA_VEHICLES);
 }
 
 void addStorageCenter(StorageCenter* sc) {
     sc->next = storageCenterHead;
     storageCenterHead = sc;
+    idIndexPut(storageCenterIndex, sc->organization, sc);
     storageCenterCount++;
+    markDirty(DATA_STORAGE_CENTERS);
+}
+
+// Forget every loaded entity and free all their nodes at once (before a
+// reload); the city graph is fixed and stays
+void clearAllData() {
+    userListHead = nullptr;
+    cropBSTRoot = nullptr;
+    orderHead = nullptr;
+    transportHead = nullptr;
+    storageHead = nullptr;
+    vehicleHead = nullptr;
+    storageCenterHead = nullptr;
+    userTable = UserTable();
+    userIdIndex = IdIndex<User>();
+    cropIdIndex = IdIndex<Crop>();
+    orderIdIndex = IdIndex<Order>();
+    buyerOrders = IdIndex<Order>();
+    cropOrders = IdIndex<Order>();
+    pendingFarmerOrders = IdIndex<Order>();
+    transportIdIndex = IdIndex<TransportRequest>();
+    storageIdIndex = IdIndex<StorageRequest>();
+    vehicleIdIndex = IdIndex<Vehicle>();
+    storageCenterIndex = IdIndex<StorageCenter>();
+    userCount = cropCount = orderCount = 0;
+    transportReqCount = storageReqCount = vehicleCount = storageCenterCount = 0;
+    userIds.reset();
+    cropIds.reset();
+    orderIds.reset();
+    transportRequestIds.reset();
+    storageRequestIds.reset();
+    vehicleIds.reset();
+    releaseNodePool<User>();
+    releaseNodePool<Crop>();
+    cropStore = CropStore();
+    releaseNodePool<Order>();
+    releaseNodePool<TransportRequest>();
+    releaseTransportLines();
+    releaseNodePool<StorageRequest>();
+    releaseNodePool<Vehicle>();
+    releaseNodePool<StorageCenter>();
 }
 
 // graph(adjacency list)
 
 void addEdge(int cityIdx, int neighborIdx, int distance) {
-    EdgeNode* newEdge = new EdgeNode;
+    EdgeNode* newEdge = newNode<EdgeNode>();
     newEdge->cityIdx = neighborIdx;
     newEdge->distance = distance;
     newEdge->next = cities[cityIdx].adjList;
@@ -429,11 +1184,12 @@ bool isInHeap(MinHeap* h, int cityIdx) {
 // ==================== ALGORITHMS ==================== 
 
 //Greedy Vehicle Assignment
-Vehicle* assignVehicle(int weight, string organization) {
+Vehicle* assignVehicle(int weight, Symbol organization) {
     Vehicle* curr = vehicleHead;
     while (curr != nullptr) {
         if (curr->organization == organization && curr->available && curr->capacity >= weight) {
             curr->available = false;
+            markDirty(DATA_VEHICLES);
             return curr;
         }
         curr = curr->next;
@@ -556,18 +1312,18 @@ void registerUser() {
     cout << "Role (farmer/buyer/storage_owner/transport_provider): ";
     cin >> role;
 
-    User* newUser = new User;
-    newUser->userId = hashID(username + to_string(userCount));
+    User* newUser = newNode<User>();
+    newUser->userId = userIds.next();
     newUser->username = username;
     newUser->password = password;
-    newUser->role = role;
+    newUser->role = (Role)intern(role);
     newUser->active = true;
-    newUser->nextInBucket = nullptr;
     newUser->nextInList = nullptr;
 
     insertUser(newUser);
     cout << "Registration successful! User ID: " << newUser->userId << "\n";
-    saveAllData();  // Save to JSON after registration
+    walLogUser(newUser);
+    walCommit();
 }
 
 bool loginUser() {
@@ -592,7 +1348,7 @@ void viewAllUsers() {
     int count = 1;
     User* curr = userListHead;
     while (curr != nullptr) {
-        cout << count++ << ". " << curr->username << " (Role: " << curr->role << ")\n";
+        cout << count++ << ". " << curr->username << " (Role: " << symbolName(curr->role) << ")\n";
         curr = curr->nextInList;
     }
 }
@@ -601,16 +1357,16 @@ void viewAllUsers() {
 
 void addCrop() {
     User* user = findUserById(currentUserId);
-    if (user == nullptr || user->role != "farmer") {
+    if (user == nullptr || user->role != ROLE_FARMER) {
         cout << "Only farmers can add crops!\n";
         return;
     }
 
-    string cropType, quality;
+    string typeName, quality;
     int quantity, price;
 
     cout << "\n=== Add New Crop ===\n";
-    cout << "Crop Type (Wheat/Rice/Mango/etc): "; cin >> cropType;
+    cout << "Crop Type (Wheat/Rice/Mango/etc): "; cin >> typeName;
     cout << "Quantity (kg): "; cin >> quantity;
     cout << "Quality (A/B/C): "; cin >> quality;
     cout << "Price per kg: "; cin >> price;
@@ -618,25 +1374,25 @@ void addCrop() {
     cout << "Expected Expiry Date: ";
     SimpleDate expiryDate = readDate();
 
-    Crop* newCrop = new Crop;
-    newCrop->cropId = hashID(cropType + to_string(cropCount));
-    newCrop->farmerId = currentUserId;
-    newCrop->cropType = toLower(cropType);
-    newCrop->quantity = quantity;
+    Crop* newCrop = newNode<Crop>();
+    newCrop->cropId = cropIds.next();
+    cropFarmerId(newCrop) = currentUserId;
+    cropType(newCrop) = intern(toLower(typeName));
+    cropQuantity(newCrop) = quantity;
     newCrop->storageQuantity = 0;
-    newCrop->quality = quality;
-    newCrop->pricePerKg = price;
-    newCrop->available = true;
+    newCrop->quality = (Quality)intern(quality);
+    cropPrice(newCrop) = price;
+    cropAvailable(newCrop) = true;
     newCrop->expiryDate = expiryDate;
     newCrop->dateAdded = getCurrentDate();
     newCrop->storageCenter = "";
     newCrop->left = newCrop->right = nullptr;
 
-    cropBSTRoot = insertCropBST(cropBSTRoot, newCrop);
-    cropCount++;
+    insertCrop(newCrop);
 
     cout << "Crop added successfully! Crop ID: " << newCrop->cropId << "\n";
-    saveAllData();  // Save to JSON after adding crop
+    walLogCrop(newCrop);
+    walCommit();
 }
 
 void viewAllCrops() {
@@ -644,7 +1400,7 @@ void viewAllCrops() {
     cout << setw(8) << "CropID" << setw(12) << "Type" << setw(8) << "Quality"
         << setw(10) << "Price/kg" << setw(12) << "Quantity" << setw(15) << "Farmer\n";
     cout << "==================================================================================\n";
-    inOrderTraversal(cropBSTRoot);
+    printAvailableCrops();
 }
 
 void compareCropPrices() {
@@ -660,8 +1416,11 @@ void compareCropPrices() {
     cout << setw(8) << "CropID" << setw(8) << "Quality" << setw(10) << "Price/kg"
         << setw(12) << "Quantity" << setw(15) << "Farmer\n";
     cout << "==================================================================================\n";
+    // Crop types are matched case-insensitively, once per distinct type
+    vector<bool> typeMatches(symbolCount());
+    for (int s = 0; s < symbolCount(); s++) typeMatches[s] = toLower(symbolName(s)) == toLower(targetCrop);
     bool found = false;
-    printCropsByTypeAndBudget(cropBSTRoot, targetCrop, maxBudget, found);
+    printCropsByTypeAndBudget(typeMatches, maxBudget, found);
     if (!found) {
         cout << "No listings found for " << targetCrop << " within budget " << maxBudget << "\n";
     }
@@ -671,7 +1430,7 @@ void compareCropPrices() {
 
 void requestCrop() {
     User* user = findUserById(currentUserId);
-    if (user == nullptr || user->role != "buyer") {
+    if (user == nullptr || user->role != ROLE_BUYER) {
         cout << "Only buyers can request crops!\n";
         return;
     }
@@ -682,22 +1441,22 @@ void requestCrop() {
     cout << "Enter Crop ID: "; cin >> cropId;
     cout << "Enter Quantity (kg): "; cin >> quantity;
 
-    Crop* crop = findCropById(cropBSTRoot, cropId);
-    if (crop == nullptr || !crop->available) {
+    Crop* crop = findCropById(cropId);
+    if (crop == nullptr || !cropAvailable(crop)) {
         cout << "Crop not found or unavailable!\n";
         return;
     }
 
-    if (crop->quantity < quantity) {
+    if (cropQuantity(crop) < quantity) {
         cout << "Insufficient quantity available!\n";
         return;
     }
 
-    Order* newOrder = new Order;
-    newOrder->orderId = orderCount + 1;
+    Order* newOrder = newNode<Order>();
+    newOrder->orderId = orderIds.next();
     newOrder->cropId = cropId;
     newOrder->buyerId = currentUserId;
-    newOrder->farmerId = crop->farmerId;
+    newOrder->farmerId = cropFarmerId(crop);
     newOrder->quantity = quantity;
     newOrder->farmerApproved = false;
     newOrder->paid = false;
@@ -708,7 +1467,8 @@ void requestCrop() {
     addOrder(newOrder);
     cout << "Crop request sent to farmer! Order ID: " << newOrder->orderId << "\n";
     cout << "Awaiting farmer approval before payment.\n";
-    saveAllData();  // Save to JSON after creating order
+    walLogOrder(newOrder);
+    walCommit();
 }
 
 void viewMyOrders() {
@@ -717,15 +1477,11 @@ void viewMyOrders() {
         << setw(12) << "Approved" << setw(8) << "Paid" << setw(12) << "Delivered\n";
     cout << "==================================================================================\n";
 
-    Order* curr = orderHead;
-    while (curr != nullptr) {
-        if (curr->buyerId == currentUserId) {
-            cout << setw(8) << curr->orderId << setw(8) << curr->cropId
-                << setw(10) << curr->quantity << setw(12) << (curr->farmerApproved ? "Yes" : "No")
-                << setw(8) << (curr->paid ? "Yes" : "No")
-                << setw(12) << (curr->delivered ? "Yes" : "No") << "\n";
-        }
-        curr = curr->next;
+    for (Order* curr = ordersForBuyer(currentUserId); curr != nullptr; curr = curr->nextByBuyer) {
+        cout << setw(8) << curr->orderId << setw(8) << curr->cropId
+            << setw(10) << curr->quantity << setw(12) << (curr->farmerApproved ? "Yes" : "No")
+            << setw(8) << (curr->paid ? "Yes" : "No")
+            << setw(12) << (curr->delivered ? "Yes" : "No") << "\n";
     }
 }
 
@@ -735,33 +1491,30 @@ void payForOrder() {
     viewMyOrders();
     cout << "Enter Order ID to pay: "; cin >> orderId;
 
-    Order* curr = orderHead;
-    while (curr != nullptr) {
-        if (curr->orderId == orderId && curr->buyerId == currentUserId) {
-            if (!curr->farmerApproved) {
-                cout << "Order not approved by farmer yet! Cannot pay.\n";
-                return;
-            }
-            if (curr->paid) {
-                cout << "Order already paid!\n";
-            }
-            else {
-                curr->paid = true;
-                curr->paymentDate = getCurrentDate();
-                cout << "Payment successful!\n";
-                saveAllData();  // Save to JSON after payment
-            }
-            return;
-        }
-        curr = curr->next;
+    Order* curr = findOrderById(orderId);
+    if (curr == nullptr || curr->buyerId != currentUserId) {
+        cout << "Order not found!\n";
+        return;
+    }
+    if (!curr->farmerApproved) {
+        cout << "Order not approved by farmer yet! Cannot pay.\n";
+        return;
+    }
+    if (curr->paid) {
+        cout << "Order already paid!\n";
+    }
+    else {
+        curr->paid = true;
+        curr->paymentDate = getCurrentDate();
+        cout << "Payment successful!\n";
+        walLogOrder(curr);
+        walCommit();
     }
-
-    cout << "Order not found!\n";
 }
 
 void viewCropRequests() {
     User* user = findUserById(currentUserId);
-    if (user == nullptr || user->role != "farmer") {
+    if (user == nullptr || user->role != ROLE_FARMER) {
         cout << "Only farmers can view crop requests!\n";
         return;
     }
@@ -771,16 +1524,12 @@ void viewCropRequests() {
         << setw(12) << "BuyerID" << setw(12) << "Status\n";
     cout << "=======================================================\n";
 
-    Order* curr = orderHead;
     bool found = false;
-    while (curr != nullptr) {
-        if (curr->farmerId == currentUserId && !curr->farmerApproved) {
-            cout << setw(8) << curr->orderId << setw(8) << curr->cropId
-                << setw(10) << curr->quantity << setw(12) << curr->buyerId
-                << setw(12) << "Pending\n";
-            found = true;
-        }
-        curr = curr->next;
+    for (Order* curr = pendingOrdersForFarmer(currentUserId); curr != nullptr; curr = curr->nextPending) {
+        cout << setw(8) << curr->orderId << setw(8) << curr->cropId
+            << setw(10) << curr->quantity << setw(12) << curr->buyerId
+            << setw(12) << "Pending\n";
+        found = true;
     }
 
     if (!found) {
@@ -796,32 +1545,29 @@ void approveCropRequest() {
     cout << "\nEnter Order ID: "; cin >> orderId;
     cout << "Approve? (1=Yes / 0=No): "; int approve; cin >> approve;
 
-    Order* curr = orderHead;
-    while (curr != nullptr) {
-        if (curr->orderId == orderId && curr->farmerId == currentUserId && !curr->farmerApproved) {
-            if (approve == 1) {
-                Crop* crop = findCropById(cropBSTRoot, curr->cropId);
-                if (crop != nullptr && crop->quantity >= curr->quantity) {
-                    curr->farmerApproved = true;
-                    curr->approvalDate = getCurrentDate();
-                    crop->quantity -= curr->quantity;
-                    if (crop->quantity == 0) crop->available = false;
-                    cout << "Request approved! Buyer can now pay.\n";
-                }
-                else {
-                    cout << "Insufficient crop quantity!\n";
-                }
-            }
-            else {
-                cout << "Request rejected.\n";
-            }
-            saveAllData();  // Save to JSON after approving/rejecting order
-            return;
+    Order* curr = findOrderById(orderId);
+    if (curr == nullptr || curr->farmerId != currentUserId || curr->farmerApproved) {
+        cout << "Request not found!\n";
+        return;
+    }
+    if (approve == 1) {
+        Crop* crop = findCropById(curr->cropId);
+        if (crop != nullptr && cropQuantity(crop) >= curr->quantity) {
+            approveOrder(curr);
+            cropQuantity(crop) -= curr->quantity;
+            if (cropQuantity(crop) == 0) cropAvailable(crop) = false;
+            walLogOrder(curr);
+            walLogCrop(crop);
+            walCommit();
+            cout << "Request approved! Buyer can now pay.\n";
+        }
+        else {
+            cout << "Insufficient crop quantity!\n";
         }
-        curr = curr->next;
     }
-
-    cout << "Request not found!\n";
+    else {
+        cout << "Request rejected.\n";
+    }
 }
 
 /* ==================== TRANSPORT MANAGEMENT ==================== */
@@ -832,7 +1578,7 @@ void requestTransport() {
 
     cout << "\n=== Request Transport ===\n";
 
-    if (user->role == "farmer") {
+    if (user->role == ROLE_FARMER) {
 
         cout << "\n=== Your Crops Accepted by Storage Centers ===\n";
         cout << setw(8) << "CropID" << setw(12) << "Type" << setw(12) << "Qty Stored"
@@ -847,12 +1593,12 @@ void requestTransport() {
 
             if (sr->accepted && !sr->released && sr->requesterId == currentUserId) {
 
-                Crop* crop = findCropById(cropBSTRoot, sr->cropId);
+                Crop* crop = findCropById(sr->cropId);
 
 
-                if (crop != nullptr && crop->farmerId == currentUserId) {
-                    cout << setw(8) << crop->cropId << setw(12) << crop->cropType
-                        << setw(12) << sr->quantity << setw(15) << sr->organization << "\n";
+                if (crop != nullptr && cropFarmerId(crop) == currentUserId) {
+                    cout << setw(8) << crop->cropId << setw(12) << symbolName(cropType(crop))
+                        << setw(12) << sr->quantity << setw(15) << symbolName(sr->organization) << "\n";
                     foundStored = true;
                 }
             }
@@ -867,9 +1613,7 @@ void requestTransport() {
         cout << "\n=== Select Crops to Transport ===\n";
         cout << "Enter crop IDs separated by space: ";
 
-        int tempCropIds[50];
-        int tempCount = 0;
-
+        vector<int> tempCropIds;
 
         string line;
         cin.ignore();
@@ -877,9 +1621,9 @@ void requestTransport() {
 
 
         int pos = 0;
-        while (pos < line.length() && tempCount < 50) {
+        while (pos < line.length()) {
 
-            while (pos < line.length() && line[pos] == ' ') pos++;
+            while (pos < line.length() && (line[pos] < '0' || line[pos] > '9')) pos++;
             if (pos >= line.length()) break;
 
  
@@ -888,23 +1632,21 @@ void requestTransport() {
                 num = num * 10 + (line[pos] - '0');
                 pos++;
             }
-            tempCropIds[tempCount++] = num;
+            tempCropIds.push_back(num);
         }
 
-        if (tempCount == 0) {
+        if (tempCropIds.empty()) {
             cout << "No crops selected!\n";
             return;
         }
 
 
-        int cropIds[50];
-        int quantities[50];
-        int validCount = 0;
+        vector<TransportLine> lines;
         int totalWeight = 0;
 
-        for (int i = 0; i < tempCount; i++) {
-            Crop* crop = findCropById(cropBSTRoot, tempCropIds[i]);
-            if (crop == nullptr || crop->farmerId != currentUserId || crop->storageQuantity == 0) {
+        for (size_t i = 0; i < tempCropIds.size(); i++) {
+            Crop* crop = findCropById(tempCropIds[i]);
+            if (crop == nullptr || cropFarmerId(crop) != currentUserId || crop->storageQuantity == 0) {
                 cout << "Crop ID " << tempCropIds[i] << " invalid or not in storage - skipped\n";
                 continue;
             }
@@ -917,13 +1659,11 @@ void requestTransport() {
                 continue;
             }
 
-            cropIds[validCount] = tempCropIds[i];
-            quantities[validCount] = qty;
+            lines.push_back({ tempCropIds[i], qty, 0 });
             totalWeight += qty;
-            validCount++;
         }
 
-        if (validCount == 0) {
+        if (lines.empty()) {
             cout << "No valid crops selected!\n";
             return;
         }
@@ -935,16 +1675,12 @@ void requestTransport() {
         cout << "Transport Organization (FastMove/AgriTrans/GreenWay): "; cin >> organization;
 
 
-        TransportRequest* req = new TransportRequest;
-        req->requestId = transportReqCount + 1;
-        req->cropCount = validCount;
+        TransportRequest* req = newNode<TransportRequest>();
+        req->requestId = transportRequestIds.next();
         req->weight = totalWeight;
-        for (int i = 0; i < validCount; i++) {
-            req->cropIds[i] = cropIds[i];
-            req->quantities[i] = quantities[i];
-        }
+        for (size_t i = 0; i < lines.size(); i++) addTransportLine(req, lines[i].cropId, lines[i].quantity, 0);
         req->budget = budget;
-        req->organization = organization;
+        req->organization = intern(organization);
         req->accepted = false;
         req->rejected = false;
         req->completed = false;
@@ -956,10 +1692,11 @@ void requestTransport() {
         cout << "\nTransport request created! Request ID: " << req->requestId << "\n";
         cout << "Total crops: " << req->cropCount << "\n";
         cout << "Total weight: " << req->weight << " kg\n";
-        saveAllData();  // Save to JSON after transport request
+        walLogTransportRequest(req);
+        walCommit();
 
     }
-    else if (user->role == "buyer") {
+    else if (user->role == ROLE_BUYER) {
 
         int orderId, budget;
         string organization;
@@ -969,17 +1706,8 @@ void requestTransport() {
 
         cout << "\nEnter Order ID: "; cin >> orderId;
 
-        Order* order = orderHead;
-        bool found = false;
-        while (order != nullptr) {
-            if (order->orderId == orderId && order->buyerId == currentUserId) {
-                found = true;
-                break;
-            }
-            order = order->next;
-        }
-
-        if (!found) {
+        Order* order = findOrderById(orderId);
+        if (order == nullptr || order->buyerId != currentUserId) {
             cout << "Invalid order ID or not your order!\n";
             return;
         }
@@ -994,20 +1722,18 @@ void requestTransport() {
             return;
         }
 
-        Crop* crop = findCropById(cropBSTRoot, order->cropId);
-        cout << "Order: " << crop->cropType << " (" << order->quantity << " kg)\n";
+        Crop* crop = findCropById(order->cropId);
+        cout << "Order: " << symbolName(cropType(crop)) << " (" << order->quantity << " kg)\n";
 
         cout << "Budget (Rs): "; cin >> budget;
         cout << "Organization (FastMove/AgriTrans/GreenWay): "; cin >> organization;
 
-        TransportRequest* req = new TransportRequest;
-        req->requestId = transportReqCount + 1;
-        req->cropIds[0] = order->cropId;
-        req->quantities[0] = order->quantity;
-        req->cropCount = 1;
+        TransportRequest* req = newNode<TransportRequest>();
+        req->requestId = transportRequestIds.next();
+        addTransportLine(req, order->cropId, order->quantity, order->orderId);
         req->weight = order->quantity;
         req->budget = budget;
-        req->organization = organization;
+        req->organization = intern(organization);
         req->accepted = false;
         req->rejected = false;
         req->completed = false;
@@ -1017,6 +1743,8 @@ void requestTransport() {
 
         addTransportRequest(req);
         cout << "\nTransport request created! Request ID: " << req->requestId << "\n";
+        walLogTransportRequest(req);
+        walCommit();
     }
     else {
         cout << "Only farmers and buyers can request transport!\n";
@@ -1026,14 +1754,14 @@ void requestTransport() {
 
 void viewTransportRequests() {
     User* user = findUserById(currentUserId);
-    if (user == nullptr || user->role != "transport_provider") {
+    if (user == nullptr || user->role != ROLE_TRANSPORT_PROVIDER) {
         cout << "Only transport providers can view requests!\n";
         return;
     }
 
-    string org = user->username; 
+    Symbol org = findSymbol(user->username);
 
-    cout << "\n=== Transport Requests for " << org << " ===\n";
+    cout << "\n=== Transport Requests for " << user->username << " ===\n";
     cout << "ReqID\tCropCount\tWeight\tBudget\tRequester\tStatus\n";
     cout << "--------------------------------------------------------------\n";
 
@@ -1066,7 +1794,7 @@ void acceptTransportRequest() {
     User* user = findUserById(currentUserId);
     if (user == nullptr) return;
 
-    string org = user->username;
+    Symbol org = findSymbol(user->username);
 
     TransportRequest* curr = transportHead;
     while (curr != nullptr) {
@@ -1075,6 +1803,9 @@ void acceptTransportRequest() {
 
             if (vehicle != nullptr) {
                 curr->accepted = true;
+                walLogTransportRequest(curr);
+                walLogVehicle(vehicle);
+                walCommit();
                 cout << "Request accepted! Vehicle " << vehicle->vehicleId
                     << " assigned (Capacity: " << vehicle->capacity << " kg)\n";
             }
@@ -1098,12 +1829,14 @@ void rejectTransportRequest() {
     User* user = findUserById(currentUserId);
     if (user == nullptr) return;
 
-    string org = user->username;
+    Symbol org = findSymbol(user->username);
 
     TransportRequest* curr = transportHead;
     while (curr != nullptr) {
         if (curr->requestId == reqId && curr->organization == org && !curr->accepted && !curr->rejected) {
             curr->rejected = true;
+            walLogTransportRequest(curr);
+            walCommit();
             cout << "Request rejected successfully!\n";
             return;
         }
@@ -1113,46 +1846,54 @@ void rejectTransportRequest() {
     cout << "Request not found, already processed, or not for your organization!\n";
 }
 
+// The order a shipment line delivers. Lines made from an order name it. A
+// farmer's own stock delivers no order. Lines saved before orders were
+// recorded only name the crop, so take the requester's own newest order
+// on it that is paid but not yet delivered; a farmer's shipment never
+// matches, since the farmer is not the buyer.
+Order* deliveredOrder(TransportRequest* tr, const TransportLine& line) {
+    if (line.orderId != 0) return findOrderById(line.orderId);
+    for (Order* o = ordersForCrop(line.cropId); o != nullptr; o = o->nextByCrop) {
+        if (o->buyerId == tr->requesterId && o->paid && !o->delivered) return o;
+    }
+    return nullptr;
+}
+
 void completeDelivery() {
     int reqId;
     cout << "\n=== Complete Delivery ===\n";
     cout << "Enter Request ID: "; cin >> reqId;
 
-    TransportRequest* tr = transportHead;
-    while (tr != nullptr) {
-        if (tr->requestId == reqId && tr->accepted) {
-            tr->completed = true;
-
-
-            for (int i = 0; i < tr->cropCount; i++) {
-                Order* ord = orderHead;
-                while (ord != nullptr) {
-                    if (ord->cropId == tr->cropIds[i]) {
-                        ord->delivered = true;
-                        break;
-                    }
-                    ord = ord->next;
-                }
-            }
+    TransportRequest* tr = findTransportRequestById(reqId);
+    if (tr == nullptr || !tr->accepted) {
+        cout << "Request not found or not accepted yet!\n";
+        return;
+    }
 
-            cout << "Delivery completed successfully!\n";
-            return;
+    tr->completed = true;
+    walLogTransportRequest(tr);
+    TransportLine* lines = transportLines(tr);
+    for (int i = 0; i < tr->cropCount; i++) {
+        Order* ord = deliveredOrder(tr, lines[i]);
+        if (ord != nullptr && !ord->delivered) {
+            ord->delivered = true;
+            walLogOrder(ord);
         }
-        tr = tr->next;
     }
+    walCommit();
 
-    cout << "Request not found or not accepted yet!\n";
+    cout << "Delivery completed successfully!\n";
 }
 
 
 void registerVehicle() {
     User* user = findUserById(currentUserId);
-    if (user == nullptr || user->role != "transport_provider") {
+    if (user == nullptr || user->role != ROLE_TRANSPORT_PROVIDER) {
         cout << "Only transport providers can register vehicles!\n";
         return;
     }
 
-    string org = user->username;
+    Symbol org = intern(user->username);
     int capacity;
     string type;
 
@@ -1162,8 +1903,8 @@ void registerVehicle() {
     cout << "Capacity (kg): ";
     cin >> capacity;
 
-    Vehicle* v = new Vehicle;
-    v->vehicleId = vehicleCount + 1;
+    Vehicle* v = newNode<Vehicle>();
+    v->vehicleId = vehicleIds.next();
     v->capacity = capacity;
     v->available = true;
     v->type = type;
@@ -1171,15 +1912,17 @@ void registerVehicle() {
     v->next = nullptr;
 
     addVehicle(v);
+    walLogVehicle(v);
+    walCommit();
     cout << "Vehicle registered successfully! Vehicle ID: " << v->vehicleId << "\n";
-    cout << "Organization: " << org << "\n";
+    cout << "Organization: " << symbolName(org) << "\n";
 }
 
 void viewMyVehicles() {
     User* user = findUserById(currentUserId);
     if (user == nullptr) return;
 
-    string org = user->username;
+    Symbol org = findSymbol(user->username);
 
     cout << "\n=== My Vehicles ===\n";
     cout << "VehicleID\tType\t\tCapacity\tStatus\n";
@@ -1213,21 +1956,21 @@ void requestStorage() {
     cout << "\n=== My Crops ===\n";
     cout << "CropID\tType\tQuantity\tQuality\tPrice/kg\n";
     cout << "-----------------------------------------------\n";
-    printFarmerCrops(cropBSTRoot, currentUserId);
+    printFarmerCrops(currentUserId);
 
     cout << "\nEnter Crop ID: "; cin >> cropId;
 
-    Crop* crop = findCropById(cropBSTRoot, cropId);
-    if (crop == nullptr || crop->farmerId != currentUserId) {
+    Crop* crop = findCropById(cropId);
+    if (crop == nullptr || cropFarmerId(crop) != currentUserId) {
         cout << "Invalid crop ID or not your crop!\n";
         return;
     }
 
     cout << "Quantity (kg): "; cin >> quantity;
 
-    if (quantity > crop->quantity) {
+    if (quantity > cropQuantity(crop)) {
         cout << "Error: Requested quantity (" << quantity << " kg) exceeds available crop quantity ("
-            << crop->quantity << " kg)!\n";
+            << cropQuantity(crop) << " kg)!\n";
         return;
     }
 
@@ -1241,7 +1984,7 @@ void requestStorage() {
     cout << "\nAvailable Storage Centers:\n";
     StorageCenter* sc = storageCenterHead;
     while (sc != nullptr) {
-        cout << sc->organization << " - Capacity: "
+        cout << symbolName(sc->organization) << " - Capacity: "
             << sc->availableCapacity << "/" << sc->totalCapacity
             << " kg, Temp: " << sc->temperature << "C\n";
         sc = sc->next;
@@ -1249,14 +1992,14 @@ void requestStorage() {
 
     cout << "Choose Organization: "; cin >> organization;
 
-    StorageRequest* req = new StorageRequest;
-    req->requestId = storageReqCount + 1;
+    StorageRequest* req = newNode<StorageRequest>();
+    req->requestId = storageRequestIds.next();
     req->cropId = cropId;
     req->ownerId = currentUserId;
-    req->cropName = crop->cropType;
+    req->cropName = symbolName(cropType(crop));
     req->quantity = quantity;
     req->budget = budget;
-    req->organization = organization;
+    req->organization = intern(organization);
     req->accepted = false;
     req->rejected = false;
     req->released = false;
@@ -1265,19 +2008,20 @@ void requestStorage() {
 
     addStorageRequest(req);
     cout << "Storage request sent! Request ID: " << req->requestId << "\n";
-    saveAllData();  // Save to JSON after storage request
+    walLogStorageRequest(req);
+    walCommit();
 }
 
 void viewStorageRequests() {
     User* user = findUserById(currentUserId);
-    if (user == nullptr || user->role != "storage_owner") {
+    if (user == nullptr || user->role != ROLE_STORAGE_OWNER) {
         cout << "Only storage owners can view requests!\n";
         return;
     }
 
-    string org = user->username; 
+    Symbol org = findSymbol(user->username);
 
-    cout << "\n=== Storage Requests for " << org << " ===\n";
+    cout << "\n=== Storage Requests for " << user->username << " ===\n";
     cout << "ReqID\tCrop\tQuantity\tBudget\tRequester\tStatus\n";
     cout << "-------------------------------------------------------------\n";
 
@@ -1304,12 +2048,14 @@ void rejectStorageRequest() {
     User* user = findUserById(currentUserId);
     if (user == nullptr) return;
 
-    string org = user->username;
+    Symbol org = findSymbol(user->username);
 
     StorageRequest* curr = storageHead;
     while (curr != nullptr) {
         if (curr->requestId == reqId && curr->organization == org && !curr->accepted && !curr->rejected) {
             curr->rejected = true;
+            walLogStorageRequest(curr);
+            walCommit();
             cout << "Request rejected successfully!\n";
             return;
         }
@@ -1321,18 +2067,18 @@ void rejectStorageRequest() {
 
 void registerStorageCenter() {
     User* user = findUserById(currentUserId);
-    if (user == nullptr || user->role != "storage_owner") {
+    if (user == nullptr || user->role != ROLE_STORAGE_OWNER) {
         cout << "Only storage owners can register storage centers!\n";
         return;
     }
 
-    string org = user->username;
+    Symbol org = intern(user->username);
 
     StorageCenter* checkExisting = storageCenterHead;
     while (checkExisting != nullptr) {
         if (checkExisting->organization == org) {
             cout << "\nYou already have a storage center registered!\n";
-            cout << "Organization: " << checkExisting->organization << "\n";
+            cout << "Organization: " << symbolName(checkExisting->organization) << "\n";
             cout << "Location: " << checkExisting->location << "\n";
             return;
         }
@@ -1353,7 +2099,7 @@ void registerStorageCenter() {
     cout << "Price per kg (Rs): ";
     cin >> pricePerKg;
 
-    StorageCenter* sc = new StorageCenter;
+    StorageCenter* sc = newNode<StorageCenter>();
     sc->organization = org;
     sc->totalCapacity = capacity;
     sc->availableCapacity = capacity;
@@ -1364,8 +2110,10 @@ void registerStorageCenter() {
     sc->next = nullptr;
 
     addStorageCenter(sc);
+    walLogStorageCenter(sc);
+    walCommit();
     cout << "\nStorage center registered successfully!\n";
-    cout << "Organization: " << org << "\n";
+    cout << "Organization: " << symbolName(org) << "\n";
     cout << "Location: " << location << "\n";
     cout << "Price per kg: Rs. " << pricePerKg << "\n";
 }
@@ -1377,7 +2125,7 @@ void allocateStorageOptimally() {
         return;
     }
 
-    string org = user->username;
+    Symbol org = findSymbol(user->username);
 
     StorageCenter* center = storageCenterHead;
     while (center != nullptr) {
@@ -1423,12 +2171,14 @@ void allocateStorageOptimally() {
             requests[i]->approvalDate = getCurrentDate();
             usedCapacity += requests[i]->quantity;
 
-            Crop* crop = findCropById(cropBSTRoot, requests[i]->cropId);
+            Crop* crop = findCropById(requests[i]->cropId);
             if (crop != nullptr) {
                 crop->storageQuantity = requests[i]->quantity;
-                crop->storageCenter = org;
-                crop->quantity -= requests[i]->quantity;
+                crop->storageCenter = symbolName(org);
+                cropQuantity(crop) -= requests[i]->quantity;
+                walLogCrop(crop);
             }
+            walLogStorageRequest(requests[i]);
 
             cout << "  - ReqID " << requests[i]->requestId << ": "
                 << requests[i]->cropName << " (" << requests[i]->quantity
@@ -1437,6 +2187,8 @@ void allocateStorageOptimally() {
     }
 
     center->availableCapacity -= usedCapacity;
+    walLogStorageCenter(center);
+    walCommit();
     cout << "\nRemaining Capacity: " << center->availableCapacity << " kg\n";
     cout << "All requesters have been notified.\n";
 }
@@ -1445,7 +2197,7 @@ void allocateStorageOptimally() {
 
 void viewStoredCrops() {
     User* user = findUserById(currentUserId);
-    if (user == nullptr || user->role != "farmer") {
+    if (user == nullptr || user->role != ROLE_FARMER) {
         cout << "Only farmers can view stored crops!\n";
         return;
     }
@@ -1455,27 +2207,18 @@ void viewStoredCrops() {
         << setw(12) << "Storage Ctr" << setw(15) << "Expiry Date\n";
     cout << "==================================================================================\n";
 
-    Crop* node = cropBSTRoot;
-    Crop* stack[100];
-    int stackTop = 0;
     bool found = false;
-
-//inorder traversal
-    while (node != nullptr || stackTop > 0) {
-        while (node != nullptr) {
-            stack[stackTop++] = node;
-            node = node->left;
-        }
-        node = stack[--stackTop];
-
-        if (node->farmerId == currentUserId && node->storageQuantity > 0) {
-            cout << setw(8) << node->cropId << setw(12) << node->cropType
+    int farmerId = currentUserId;
+    vector<int> rows = selectCropRows([farmerId](int row) { return cropStore.farmerId[row] == farmerId; });
+    for (size_t i = 0; i < rows.size(); i++) {
+        Crop* node = cropStore.record[rows[i]];
+        if (node->storageQuantity > 0) {
+            cout << setw(8) << node->cropId << setw(12) << symbolName(cropType(node))
                 << setw(12) << node->storageQuantity << setw(12) << node->storageCenter
                 << setw(15) << (to_string(node->expiryDate.day) + "/" + to_string(node->expiryDate.month)
                     + "/" + to_string(node->expiryDate.year)) << "\n";
             found = true;
         }
-        node = node->right;
     }
 
     if (!found) {
@@ -1485,7 +2228,7 @@ void viewStoredCrops() {
 
 void releaseStoredCrop() {
     User* user = findUserById(currentUserId);
-    if (user == nullptr || user->role != "farmer") {
+    if (user == nullptr || user->role != ROLE_FARMER) {
         cout << "Only farmers can release stored crops!\n";
         return;
     }
@@ -1496,8 +2239,8 @@ void releaseStoredCrop() {
     cout << "\nEnter Crop ID to release: "; cin >> cropId;
     cout << "Quantity to release (kg): "; cin >> quantity;
 
-    Crop* crop = findCropById(cropBSTRoot, cropId);
-    if (crop == nullptr || crop->farmerId != currentUserId || crop->storageQuantity == 0) {
+    Crop* crop = findCropById(cropId);
+    if (crop == nullptr || cropFarmerId(crop) != currentUserId || crop->storageQuantity == 0) {
         cout << "Invalid crop ID or not in storage!\n";
         return;
     }
@@ -1508,32 +2251,35 @@ void releaseStoredCrop() {
     }
 
     crop->storageQuantity -= quantity;
-    crop->quantity += quantity;
+    cropQuantity(crop) += quantity;
     crop->storageCenter = "";
+    walLogCrop(crop);
 
     StorageRequest* currReq = storageHead;
     while (currReq != nullptr) {
         if (currReq->cropId == cropId && currReq->requesterId == currentUserId && !currReq->released) {
             currReq->released = true;
             currReq->releaseDate = getCurrentDate();
+            walLogStorageRequest(currReq);
             break;
         }
         currReq = currReq->next;
     }
+    walCommit();
 
-    cout << "\n" << quantity << " kg of " << crop->cropType << " released to inventory!\n";
+    cout << "\n" << quantity << " kg of " << symbolName(cropType(crop)) << " released to inventory!\n";
     cout << "Storage Quantity: " << crop->storageQuantity << " kg\n";
-    cout << "Available Quantity: " << crop->quantity << " kg\n";
+    cout << "Available Quantity: " << cropQuantity(crop) << " kg\n";
 }
 
 void updateStorageCapacity() {
     User* user = findUserById(currentUserId);
-    if (user == nullptr || user->role != "storage_owner") {
+    if (user == nullptr || user->role != ROLE_STORAGE_OWNER) {
         cout << "Only storage owners can update capacity!\n";
         return;
     }
 
-    string org = user->username;
+    Symbol org = findSymbol(user->username);
     int additionalCapacity;
 
     cout << "\n=== Update Storage Capacity ===\n";
@@ -1544,6 +2290,8 @@ void updateStorageCapacity() {
         if (curr->organization == org) {
             curr->totalCapacity += additionalCapacity;
             curr->availableCapacity += additionalCapacity;
+            walLogStorageCenter(curr);
+            walCommit();
             cout << "\nCapacity updated successfully!\n";
             cout << "New Total Capacity: " << curr->totalCapacity << " kg\n";
             cout << "Available Capacity: " << curr->availableCapacity << " kg\n";
@@ -1557,19 +2305,19 @@ void updateStorageCapacity() {
 
 void viewMyStorageCenter() {
     User* user = findUserById(currentUserId);
-    if (user == nullptr || user->role != "storage_owner") {
+    if (user == nullptr || user->role != ROLE_STORAGE_OWNER) {
         cout << "Only storage owners can view their center!\n";
         return;
     }
 
-    string org = user->username;
+    Symbol org = findSymbol(user->username);
 
     cout << "\n=== My Storage Center ===\n";
 
     StorageCenter* curr = storageCenterHead;
     while (curr != nullptr) {
         if (curr->organization == org) {
-            cout << "Organization: " << curr->organization << "\n";
+            cout << "Organization: " << symbolName(curr->organization) << "\n";
             cout << "Location: " << curr->location << "\n";
             cout << "Registration Date: " << curr->registrationDate.day << "/"
                 << curr->registrationDate.month << "/" << curr->registrationDate.year << "\n";
@@ -1649,11 +2397,11 @@ void viewStatistics() {
         return;
     }
 
-    string role = user->role;
+    Role role = user->role;
 
-    if (role == "farmer") {
+    if (role == ROLE_FARMER) {
         cout << "\n=== My Farmer Statistics ===\n\n";
-        int myCrops = countCropsForFarmer(cropBSTRoot, currentUserId);
+        int myCrops = countCropsForFarmer(currentUserId);
         cout << "CROP STATISTICS:\n";
         cout << "  My Total Crops Listed: " << myCrops << "\n\n";
         int myStorageReq = 0, acceptedStorage = 0;
@@ -1670,17 +2418,13 @@ void viewStatistics() {
         cout << "  Accepted: " << acceptedStorage << "\n";
         cout << "  Pending: " << (myStorageReq - acceptedStorage) << "\n";
     }
-    else if (role == "buyer") {
+    else if (role == ROLE_BUYER) {
         cout << "\n=== My Buyer Statistics ===\n\n";
         int myOrders = 0, paidOrders = 0, deliveredOrders = 0;
-        Order* o = orderHead;
-        while (o != nullptr) {
-            if (o->buyerId == currentUserId) {
-                myOrders++;
-                if (o->paid) paidOrders++;
-                if (o->delivered) deliveredOrders++;
-            }
-            o = o->next;
+        for (Order* o = ordersForBuyer(currentUserId); o != nullptr; o = o->nextByBuyer) {
+            myOrders++;
+            if (o->paid) paidOrders++;
+            if (o->delivered) deliveredOrders++;
         }
         cout << "ORDER STATISTICS:\n";
         cout << "  My Total Orders: " << myOrders << "\n";
@@ -1703,9 +2447,9 @@ void viewStatistics() {
         cout << "  Completed: " << completedTransport << "\n";
         cout << "  Pending: " << (myTransportReq - acceptedTransport) << "\n";
     }
-    else if (role == "transport_provider") {
+    else if (role == ROLE_TRANSPORT_PROVIDER) {
         cout << "\n=== My Transport Provider Statistics ===\n\n";
-        string org = user->username;
+        Symbol org = findSymbol(user->username);
         int orgRequests = 0, acceptedReq = 0, completedReq = 0;
         TransportRequest* tr = transportHead;
         while (tr != nullptr) {
@@ -1716,7 +2460,7 @@ void viewStatistics() {
             }
             tr = tr->next;
         }
-        cout << "TRANSPORT STATISTICS for " << org << ":\n";
+        cout << "TRANSPORT STATISTICS for " << user->username << ":\n";
         cout << "  Total Requests Received: " << orgRequests << "\n";
         cout << "  Accepted: " << acceptedReq << "\n";
         cout << "  Completed: " << completedReq << "\n";
@@ -1731,18 +2475,18 @@ void viewStatistics() {
             }
             v = v->next;
         }
-        cout << "VEHICLES for " << org << ":\n";
+        cout << "VEHICLES for " << user->username << ":\n";
         cout << "  Total Vehicles: " << myVehicles << "\n";
         cout << "  Available: " << availableVehicles << "\n";
         cout << "  In Use: " << (myVehicles - availableVehicles) << "\n";
     }
-    else if (role == "storage_owner") {
+    else if (role == ROLE_STORAGE_OWNER) {
         cout << "\n=== My Storage Owner Statistics ===\n\n";
-        string org = user->username;
+        Symbol org = findSymbol(user->username);
         StorageCenter* center = storageCenterHead;
         while (center != nullptr) {
             if (center->organization == org) {
-                cout << "STORAGE CENTER: " << org << "\n";
+                cout << "STORAGE CENTER: " << symbolName(org) << "\n";
                 cout << "  Location: " << center->location << "\n";
                 cout << "  Total Capacity: " << center->totalCapacity << " kg\n";
                 cout << "  Available Capacity: " << center->availableCapacity << " kg\n";
@@ -1764,7 +2508,7 @@ void viewStatistics() {
             }
             sr = sr->next;
         }
-        cout << "STORAGE REQUESTS for " << org << ":\n";
+        cout << "STORAGE REQUESTS for " << user->username << ":\n";
         cout << "  Total Requests Received: " << orgRequests << "\n";
         cout << "  Accepted: " << acceptedReq << "\n";
         cout << "  Pending: " << (orgRequests - acceptedReq) << "\n";
@@ -1776,10 +2520,10 @@ void viewSystemStatistics() {
     int farmers = 0, buyers = 0, storageOwners = 0, transportProviders = 0;
     User* u = userListHead;
     while (u != nullptr) {
-        if (u->role == "farmer") farmers++;
-        else if (u->role == "buyer") buyers++;
-        else if (u->role == "storage_owner") storageOwners++;
-        else if (u->role == "transport_provider") transportProviders++;
+        if (u->role == ROLE_FARMER) farmers++;
+        else if (u->role == ROLE_BUYER) buyers++;
+        else if (u->role == ROLE_STORAGE_OWNER) storageOwners++;
+        else if (u->role == ROLE_TRANSPORT_PROVIDER) transportProviders++;
         u = u->nextInList;
     }
     cout << "USER STATISTICS:\n";
@@ -1787,7 +2531,23 @@ void viewSystemStatistics() {
     cout << "  Farmers: " << farmers << "\n";
     cout << "  Buyers: " << buyers << "\n";
     cout << "  Storage Owners: " << storageOwners << "\n";
-    cout << "  Transport Providers: " << transportProviders << "\n\n";
+    cout << "  Transport Providers: " << transportProviders << "\n";
+    UserTableStats table = getUserTableStats();
+    streamsize oldPrecision = cout.precision();
+    cout << "  Username Table: " << table.count << "/" << table.capacity << " slots (load "
+         << fixed << setprecision(2) << table.loadFactor << ", avg probe " << table.avgProbe
+         << ", max probe " << table.maxProbe << ")\n";
+    NodePoolStats pools = getNodePoolStats();
+    cout << "  Node Pools: " << pools.live << " nodes (" << pools.free << " free) in " << pools.slabs
+         << " slabs, " << pools.bytes / 1024 << " KB\n";
+    cout << "  Interned Strings: " << symbolCount() << " distinct roles, qualities, crop types and organizations\n";
+    PersistenceStats persisted = getPersistenceStats();
+    cout << "  Persistence: " << persisted.queueDepth << " queued, " << persisted.flushes << " flushes, last "
+         << persisted.lastFlushMs << " ms, avg "
+         << (persisted.flushes > 0 ? persisted.totalFlushMs / persisted.flushes : 0.0)
+         << " ms, max " << persisted.maxFlushMs << " ms\n\n";
+    cout.unsetf(ios::fixed);
+    cout.precision(oldPrecision);
     cout << "CROP STATISTICS:\n";
     cout << "  Total Crops Listed: " << cropCount << "\n";
     cout << "\n";
@@ -1842,12 +2602,12 @@ void initializeSampleData() {
     // Sample Vehicles
     string vehicleOrgs[] = { "FastMove", "FastMove", "AgriTrans", "GreenWay", "AgriTrans" };
     for (int i = 0; i < 5; i++) {
-        Vehicle* v = new Vehicle;
+        Vehicle* v = newNode<Vehicle>();
         v->vehicleId = i + 1;
         v->capacity = (i == 0) ? 500 : (i == 1) ? 1000 : (i == 2) ? 1500 : (i == 3) ? 2000 : 800;
         v->available = true;
         v->type = (i == 0) ? "Van" : (i == 1) ? "Truck" : (i == 2) ? "Large Truck" : (i == 3) ? "Container" : "Pickup";
-        v->organization = vehicleOrgs[i];
+        v->organization = intern(vehicleOrgs[i]);
         v->next = nullptr;
         addVehicle(v);
     }
@@ -1860,8 +2620,8 @@ void initializeSampleData() {
     int prices[] = { 50, 45, 55, 48 };  // Price per kg
 
     for (int i = 0; i < 4; i++) {
-        StorageCenter* sc = new StorageCenter;
-        sc->organization = orgs[i];
+        StorageCenter* sc = newNode<StorageCenter>();
+        sc->organization = intern(orgs[i]);
         sc->totalCapacity = caps[i];
         sc->availableCapacity = caps[i];
         sc->temperature = temps[i];
@@ -1874,50 +2634,46 @@ void initializeSampleData() {
 
     // Sample Users
     // Farmer
-    User* u1 = new User;
+    User* u1 = newNode<User>();
     u1->userId = 1001;
     u1->username = "farmer1";
     u1->password = "pass123";
-    u1->role = "farmer";
+    u1->role = ROLE_FARMER;
     u1->active = true;
-    u1->nextInBucket = nullptr;
     u1->nextInList = nullptr;
     insertUser(u1);
 
     // Buyer
-    User* u2 = new User;
+    User* u2 = newNode<User>();
     u2->userId = 1002;
     u2->username = "buyer1";
     u2->password = "pass123";
-    u2->role = "buyer";
+    u2->role = ROLE_BUYER;
     u2->active = true;
-    u2->nextInBucket = nullptr;
     u2->nextInList = nullptr;
     insertUser(u2);
 
     // Transport Providers
     string transportOrgs[] = { "FastMove", "AgriTrans", "GreenWay" };
     for (int i = 0; i < 3; i++) {
-        User* u = new User;
+        User* u = newNode<User>();
         u->userId = 1100 + i;
         u->username = transportOrgs[i];
         u->password = "pass123";
-        u->role = "transport_provider";
+        u->role = ROLE_TRANSPORT_PROVIDER;
         u->active = true;
-        u->nextInBucket = nullptr;
         u->nextInList = nullptr;
         insertUser(u);
     }
 
     // Storage Owners
     for (int i = 0; i < 4; i++) {
-        User* u = new User;
+        User* u = newNode<User>();
         u->userId = 1200 + i;
         u->username = orgs[i];
         u->password = "pass123";
-        u->role = "storage_owner";
+        u->role = ROLE_STORAGE_OWNER;
         u->active = true;
-        u->nextInBucket = nullptr;
         u->nextInList = nullptr;
         insertUser(u);
     }
@@ -1926,24 +2682,23 @@ void initializeSampleData() {
     string cropTypes[] = { "Wheat", "Rice", "Mango" };
     int cropPrices[] = { 60, 80, 150 };
     int quantities[] = { 5000, 3000, 2000 };
-    string qualities[] = { "A", "B", "A" };
+    Quality qualities[] = { QUALITY_A, QUALITY_B, QUALITY_A };
 
     for (int i = 0; i < 3; i++) {
-        Crop* c = new Crop;
+        Crop* c = newNode<Crop>();
         c->cropId = 2001 + i;
-        c->farmerId = 1001;
-        c->cropType = cropTypes[i];
-        c->quantity = quantities[i];
+        cropFarmerId(c) = 1001;
+        cropType(c) = intern(cropTypes[i]);
+        cropQuantity(c) = quantities[i];
         c->storageQuantity = 0;
         c->quality = qualities[i];
-        c->pricePerKg = cropPrices[i];
-        c->available = true;
+        cropPrice(c) = cropPrices[i];
+        cropAvailable(c) = true;
         c->dateAdded = { 1, 1, 2026 };
         c->expiryDate = { 31, 12, 2026 };
         c->storageCenter = "";
         c->left = c->right = nullptr;
-        cropBSTRoot = insertCropBST(cropBSTRoot, c);
-        cropCount++;
+        insertCrop(c);
     }
 
     // Sample Cities Network
@@ -2007,7 +2762,7 @@ void farmerMenu() {
                 cout << "\n=== My Crops ===\n";
                 cout << "CropID\tType\tQuantity\tQuality\tPrice/kg\tDate\n";
                 cout << "---------------------------------------------------------\n";
-                printFarmerCrops(cropBSTRoot, currentUserId);
+                printFarmerCrops(currentUserId);
             }
             else if (subChoice == 2) {
                 viewStoredCrops();
@@ -2044,7 +2799,7 @@ void farmerMenu() {
                 if (sr->requesterId == currentUserId) {
                     string status = sr->rejected ? "Rejected" : (sr->accepted ? "Accepted" : "Pending");
                     cout << sr->requestId << "\t" << sr->cropName << "\t"
-                        << sr->quantity << "\t\t" << sr->organization << "\t\t"
+                        << sr->quantity << "\t\t" << symbolName(sr->organization) << "\t\t"
                         << status << "\n";
                 }
                 sr = sr->next;
@@ -2061,7 +2816,7 @@ void farmerMenu() {
                     else if (tr->accepted) status = "In Progress";
                     else status = "Pending";
                     cout << tr->requestId << "\t" << tr->cropCount << "\t\t"
-                        << tr->weight << "\t" << tr->organization << "\t\t"
+                        << tr->weight << "\t" << symbolName(tr->organization) << "\t\t"
                         << status << "\n";
                 }
                 tr = tr->next;
@@ -2075,7 +2830,7 @@ void farmerMenu() {
             StorageRequest* sr = storageHead;
             while (sr != nullptr) {
                 if (sr->requesterId == currentUserId && sr->accepted) {
-                    cout << "✓ Storage request #" << sr->requestId << " accepted by " << sr->organization << "\n";
+                    cout << "✓ Storage request #" << sr->requestId << " accepted by " << symbolName(sr->organization) << "\n";
                     found = true;
                 }
                 sr = sr->next;
@@ -2084,13 +2839,13 @@ void farmerMenu() {
             while (tr != nullptr) {
                 if (tr->requesterId == currentUserId) {
                     if (tr->accepted) {
-                        cout << "✓ Transport request #" << tr->requestId << " accepted by " << tr->organization;
+                        cout << "✓ Transport request #" << tr->requestId << " accepted by " << symbolName(tr->organization);
                         if (tr->completed) cout << " and completed";
                         cout << "\n";
                         found = true;
                     }
                     else if (tr->rejected) {
-                        cout << "✗ Transport request #" << tr->requestId << " rejected by " << tr->organization
+                        cout << "✗ Transport request #" << tr->requestId << " rejected by " << symbolName(tr->organization)
                             << " (insufficient vehicle capacity)\n";
                         found = true;
                     }
@@ -2132,17 +2887,13 @@ void buyerMenu() {
             cout << "\n=== My Orders & Delivery Status ===\n";
             cout << "OrderID\tCropID\tQuantity\tApproved\tPaid\tDelivered\tDate\n";
             cout << "------------------------------------------------------\n";
-            Order* o = orderHead;
-            while (o != nullptr) {
-                if (o->buyerId == currentUserId) {
-                    cout << o->orderId << "\t" << o->cropId << "\t"
-                        << o->quantity << "\t\t"
-                        << (o->farmerApproved ? "Yes" : "No") << "\t"
-                        << (o->paid ? "Yes" : "No") << "\t"
-                        << (o->delivered ? "Yes" : "No") << "\t"
-                        << formatDate(o->orderDate) << "\n";
-                }
-                o = o->next;
+            for (Order* o = ordersForBuyer(currentUserId); o != nullptr; o = o->nextByBuyer) {
+                cout << o->orderId << "\t" << o->cropId << "\t"
+                    << o->quantity << "\t\t"
+                    << (o->farmerApproved ? "Yes" : "No") << "\t"
+                    << (o->paid ? "Yes" : "No") << "\t"
+                    << (o->delivered ? "Yes" : "No") << "\t"
+                    << formatDate(o->orderDate) << "\n";
             }
             cout << "\nTRANSPORT REQUESTS:\n";
             cout << "ReqID\tCropCount\tWeight\tOrganization\tStatus\n";
@@ -2156,7 +2907,7 @@ void buyerMenu() {
                     else if (tr->accepted) status = "In Progress";
                     else status = "Pending";
                     cout << tr->requestId << "\t" << tr->cropCount << "\t\t"
-                        << tr->weight << "\t" << tr->organization << "\t\t"
+                        << tr->weight << "\t" << symbolName(tr->organization) << "\t\t"
                         << status << "\n";
                 }
                 tr = tr->next;
@@ -2170,7 +2921,7 @@ void buyerMenu() {
             TransportRequest* tr = transportHead;
             while (tr != nullptr) {
                 if (tr->requesterId == currentUserId && tr->accepted) {
-                    cout << "✓ Transport request #" << tr->requestId << " accepted by " << tr->organization;
+                    cout << "✓ Transport request #" << tr->requestId << " accepted by " << symbolName(tr->organization);
                     if (tr->completed) cout << " and completed";
                     cout << "\n";
                     found = true;
@@ -2215,7 +2966,7 @@ void transportProviderMenu() {
                     while (curr != nullptr) {
                         if (curr->requestId == reqId && !curr->accepted) {
                             User* user = findUserById(currentUserId);
-                            string org = (user != nullptr) ? user->username : "";
+                            Symbol org = (user != nullptr) ? findSymbol(user->username) : NO_SYMBOL;
 
 
                             int remainingWeight = curr->weight;
@@ -2228,6 +2979,7 @@ void transportProviderMenu() {
                                     if (v->capacity >= remainingWeight) {
 
                                         v->available = false;
+                                        walLogVehicle(v);
                                         vehiclesAssigned++;
                                         cout << "Vehicle " << v->vehicleId << " assigned (Capacity: "
                                             << v->capacity << " kg, carrying " << remainingWeight << " kg)\n";
@@ -2236,6 +2988,7 @@ void transportProviderMenu() {
                                     else {
 
                                         v->available = false;
+                                        walLogVehicle(v);
                                         vehiclesAssigned++;
                                         cout << "Vehicle " << v->vehicleId << " assigned (Capacity: "
                                             << v->capacity << " kg, fully loaded)\n";
@@ -2253,6 +3006,7 @@ void transportProviderMenu() {
                                 while (restoreV != nullptr && restored < vehiclesAssigned) {
                                     if (restoreV->organization == org && !restoreV->available) {
                                         restoreV->available = true;
+                                        walLogVehicle(restoreV);
                                         restored++;
                                     }
                                     restoreV = restoreV->next;
@@ -2267,6 +3021,8 @@ void transportProviderMenu() {
                                 cout << "\nRequest accepted! Total " << vehiclesAssigned
                                     << " vehicle(s) assigned for " << curr->weight << " kg\n";
                             }
+                            walLogTransportRequest(curr);
+                            walCommit();
                             break;
                         }
                         curr = curr->next;
@@ -2279,6 +3035,8 @@ void transportProviderMenu() {
                     while (curr != nullptr) {
                         if (curr->requestId == reqId && !curr->rejected && !curr->accepted) {
                             curr->rejected = true;
+                            walLogTransportRequest(curr);
+                            walCommit();
                             cout << "Request rejected!\n";
                             break;
                         }
@@ -2323,7 +3081,7 @@ void storageOwnerMenu() {
                 cin >> action;
 
                 User* user = findUserById(currentUserId);
-                string org = (user != nullptr) ? user->username : "";
+                Symbol org = (user != nullptr) ? findSymbol(user->username) : NO_SYMBOL;
                 StorageCenter* center = storageCenterHead;
                 while (center != nullptr && center->organization != org) {
                     center = center->next;
@@ -2346,18 +3104,24 @@ void storageOwnerMenu() {
                             curr->approvalDate = getCurrentDate();
                             center->availableCapacity -= curr->quantity;
 
-                            Crop* crop = findCropById(cropBSTRoot, curr->cropId);
+                            Crop* crop = findCropById(curr->cropId);
                             if (crop != nullptr) {
                                 crop->storageQuantity = curr->quantity;
-                                crop->storageCenter = org;
-                                crop->quantity -= curr->quantity;
+                                crop->storageCenter = symbolName(org);
+                                cropQuantity(crop) -= curr->quantity;
+                                walLogCrop(crop);
                             }
+                            walLogStorageRequest(curr);
+                            walLogStorageCenter(center);
+                            walCommit();
 
                             cout << "Request accepted and capacity updated!\n";
                             requestProcessed = true;
                         }
                         else if (action == 2) {
                             curr->rejected = true;
+                            walLogStorageRequest(curr);
+                            walCommit();
                             cout << "Request rejected successfully!\n";
                             requestProcessed = true;
                         }
@@ -2380,8 +3144,25 @@ void storageOwnerMenu() {
 // Include JSON handler implementation
 #include "json_handler.cpp"
 
-int main() {
-    // Load existing data from JSON files
+int main(int argc, char* argv[]) {
+    // --wal-sync=always|batched|never picks when the write-ahead log is fsynced
+    // --snapshot=json|binary picks the format saved snapshots use
+    // --convert=json2bin|bin2json rewrites the data folder in the other format and exits
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--wal-sync=always") setWalSyncPolicy(WAL_SYNC_ALWAYS);
+        else if (arg == "--wal-sync=batched") setWalSyncPolicy(WAL_SYNC_BATCHED);
+        else if (arg == "--wal-sync=never") setWalSyncPolicy(WAL_SYNC_NEVER);
+        else if (arg == "--snapshot=json") setSnapshotFormat(SNAPSHOT_JSON);
+        else if (arg == "--snapshot=binary") setSnapshotFormat(SNAPSHOT_BINARY);
+        else if (arg == "--convert=json2bin" || arg == "--convert=bin2json") {
+            convertSnapshot(arg == "--convert=json2bin" ? SNAPSHOT_BINARY : SNAPSHOT_JSON);
+            return 0;
+        }
+        else cerr << "Unknown option: " << arg << "\n";
+    }
+
+    // Load saved data (binary snapshot or JSON files, then the write-ahead log)
     loadAllData();
     
     // If no data loaded, initialize sample data
@@ -2412,12 +3193,12 @@ int main() {
             if (loginUser()) {
                 User* user = findUserById(currentUserId);
                 if (user != nullptr) {
-                    string role = user->role;
+                    Role role = user->role;
 
-                    if (role == "farmer") farmerMenu();
-                    else if (role == "buyer") buyerMenu();
-                    else if (role == "transport_provider") transportProviderMenu();
-                    else if (role == "storage_owner") storageOwnerMenu();
+                    if (role == ROLE_FARMER) farmerMenu();
+                    else if (role == ROLE_BUYER) buyerMenu();
+                    else if (role == ROLE_TRANSPORT_PROVIDER) transportProviderMenu();
+                    else if (role == ROLE_STORAGE_OWNER) storageOwnerMenu();
 
                     currentUserId = -1;
                 }
@@ -2430,8 +3211,11 @@ int main() {
         }
     } while (choice != 0);
 
-    cout << "\n[Saving] Saving all data to JSON files...\n";
+    cout << "\n[Saving] Saving all data...\n";
     saveAllData();
+    flushPersistence();
+    PersistenceStats persisted = getPersistenceStats();
+    cout << "[Saving] " << persisted.bytesWritten << " bytes written in " << persisted.flushes << " flushes.\n";
     cout << "Thank you for using AgriConnect Pakistan!\n";
     return 0;
 }
\ No newline at end of file
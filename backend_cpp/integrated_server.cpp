@@ -1,18 +1,64 @@
 #include <iostream>
-#include <winsock2.h>
 #include <thread>
 #include <string>
 #include <cstring>
 #include <sstream>
 #include <iomanip>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <ctime>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <unordered_map>
+#include <memory>
 
+#ifdef _WIN32
+#include <winsock2.h>
 #pragma comment(lib, "ws2_32.lib")
+typedef int socklen_t;
+const int SEND_FLAGS = 0;
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <cerrno>
+// Winsock names used throughout this file, mapped onto BSD sockets
+typedef int SOCKET;
+typedef sockaddr_in SOCKADDR_IN;
+typedef sockaddr SOCKADDR;
+const SOCKET INVALID_SOCKET = -1;
+const int SOCKET_ERROR = -1;
+const int SEND_FLAGS = MSG_NOSIGNAL;
+inline int closesocket(SOCKET s) { return close(s); }
+inline int WSAGetLastError() { return errno; }
+inline int WSACleanup() { return 0; }
+#endif
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <poll.h>
+#endif
 
 using namespace std;
 
 const int PORT = 8080;
 const int BUFFER_SIZE = 4096;
-const int HASH_TABLE_SIZE = 101;
+
+// Event loop limits (epoll mode)
+const int MAX_CONNECTIONS = 65536;        // hard cap on concurrently open client sockets
+const size_t MAX_OUTPUT_BACKLOG = 64 * 1024; // unsent bytes before pipelined requests are held back
+const int MAX_EPOLL_EVENTS = 256;
+
+// Persistent connections: idle keep-alive sockets are closed after this many seconds
+const int KEEP_ALIVE_TIMEOUT_SEC = 5;
+bool keepAliveEnabled = true;  // --keep-alive=off forces Connection: close
 
 // Data structures from agriconnect_simple.cpp
 struct SimpleDate {
@@ -29,7 +75,6 @@ struct User {
     string email;
     string phone;
     bool active;
-    User* nextInBucket;
     User* nextInList;
 };
 
@@ -44,27 +89,50 @@ struct Crop {
     SimpleDate dateAdded;
     Crop* left;
     Crop* right;
+    int height;  // AVL subtree height, 1 for a leaf
 };
 
 // Global data storage
-User* userHashTable[HASH_TABLE_SIZE] = { nullptr };
 User* userListHead = nullptr;
 Crop* cropBSTRoot = nullptr;
 int userCount = 0;
 int cropCount = 0;
 
-// Utility functions
-int hashUsername(string username) {
-    int h = 0;
-    for (size_t i = 0; i < username.length(); i++)
-        h = (h * 31 + username[i]) % HASH_TABLE_SIZE;
-    return h;
-}
+// Every connection thread shares the store, so each collection has its own
+// reader-writer lock: lookups take it shared and run side by side, inserts
+// take it exclusively. Listings and /status read published snapshots
+// instead (see READ SNAPSHOTS). The store functions below do not lock; the
+// route handlers do. When a handler needs both, it takes cropsLock before
+// usersLock (crop listings look up farmer names). Nodes are never freed,
+// so a pointer stays valid after its lock is released.
+shared_mutex usersLock;  // userTable, userIdIndex, userListHead, userCount
+shared_mutex cropsLock;  // cropBSTRoot, cropIdIndex, cropCount
 
-int hashID(string key) {
-    int h = 0;
-    for (size_t i = 0; i < key.length(); i++)
-        h = (h * 31 + key[i]) % 100000;
+// Id allocators: next() is one fetch_add and needs no lock, and ids only
+// grow, unlike the old hash of name and count that collided at scale.
+// insertUser/insertCrop observe() every id they link, so ids assigned
+// elsewhere (seeded data) are never handed out again.
+struct IdAllocator {
+    atomic<int> last{0};
+    
+    int next() { return last.fetch_add(1) + 1; }
+    
+    void observe(int id) {
+        int seen = last.load();
+        while (seen < id && !last.compare_exchange_weak(seen, id)) {}
+    }
+};
+
+IdAllocator userIds, cropIds;
+
+// Utility functions
+// FNV-1a: mixes every byte into all 32 bits, unlike the old modulo-101 rolling hash
+unsigned int hashUsername(const string& username) {
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < username.length(); i++) {
+        h ^= (unsigned char)username[i];
+        h *= 16777619u;
+    }
     return h;
 }
 
@@ -76,248 +144,1879 @@ string formatDate(SimpleDate d) {
     return oss.str();
 }
 
+/* ==================== JSON BODY READER ====================
+ * One pass over a request body records every top-level field of the
+ * object as (key, raw value) string_views into the body, with no
+ * allocation. Handlers then read fields by key from that single parse;
+ * string values are unescaped only when read.
+ */
+
+const int MAX_JSON_FIELDS = 32;
+
+enum JsonType { JSON_STRING, JSON_NUMBER, JSON_BOOL, JSON_NULL, JSON_OBJECT, JSON_ARRAY };
+
+struct JsonField {
+    string_view key;
+    string_view value;  // string contents without quotes, or the raw literal/number/container text
+    JsonType type;
+};
+
+struct JsonObject {
+    JsonField fields[MAX_JSON_FIELDS];
+    int fieldCount;
+};
+
+void skipWhitespace(string_view text, size_t& pos) {
+    while (pos < text.length() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n' || text[pos] == '\r'))
+        pos++;
+}
+
+// pos is on the opening quote; leaves pos after the closing quote
+bool scanJsonString(string_view text, size_t& pos, string_view& contents) {
+    size_t start = ++pos;
+    while (pos < text.length() && text[pos] != '"') {
+        if (text[pos] == '\\') pos++;
+        pos++;
+    }
+    if (pos >= text.length()) return false;
+    contents = text.substr(start, pos - start);
+    pos++;
+    return true;
+}
+
+// pos is on '{' or '['; leaves pos after the matching close bracket
+bool skipJsonContainer(string_view text, size_t& pos) {
+    int depth = 0;
+    string_view ignored;
+    while (pos < text.length()) {
+        char c = text[pos];
+        if (c == '"') {
+            if (!scanJsonString(text, pos, ignored)) return false;
+            continue;
+        }
+        if (c == '{' || c == '[') depth++;
+        else if (c == '}' || c == ']') depth--;
+        pos++;
+        if (depth == 0) return true;
+    }
+    return false;
+}
+
+bool scanJsonValue(string_view text, size_t& pos, JsonField* field) {
+    if (pos >= text.length()) return false;
+    size_t start = pos;
+    char c = text[pos];
+    if (c == '"') {
+        field->type = JSON_STRING;
+        return scanJsonString(text, pos, field->value);
+    }
+    if (c == '{' || c == '[') {
+        field->type = (c == '{') ? JSON_OBJECT : JSON_ARRAY;
+        if (!skipJsonContainer(text, pos)) return false;
+    } else if (text.compare(pos, 4, "true") == 0 || text.compare(pos, 4, "null") == 0) {
+        field->type = (c == 't') ? JSON_BOOL : JSON_NULL;
+        pos += 4;
+    } else if (text.compare(pos, 5, "false") == 0) {
+        field->type = JSON_BOOL;
+        pos += 5;
+    } else {
+        field->type = JSON_NUMBER;
+        while (pos < text.length() && (isdigit((unsigned char)text[pos]) || strchr("+-.eE", text[pos]) != nullptr))
+            pos++;
+        if (pos == start) return false;
+    }
+    field->value = text.substr(start, pos - start);
+    return true;
+}
+
+// Tokenize a JSON object body in a single pass; false if it is not a well-formed object.
+// Fields past MAX_JSON_FIELDS are validated but not recorded.
+bool parseJsonObject(string_view text, JsonObject* obj) {
+    obj->fieldCount = 0;
+    size_t pos = 0;
+    skipWhitespace(text, pos);
+    if (pos >= text.length() || text[pos] != '{') return false;
+    pos++;
+    skipWhitespace(text, pos);
+    if (pos < text.length() && text[pos] == '}') return true;
+    
+    while (pos < text.length()) {
+        JsonField field;
+        if (text[pos] != '"' || !scanJsonString(text, pos, field.key)) return false;
+        skipWhitespace(text, pos);
+        if (pos >= text.length() || text[pos] != ':') return false;
+        pos++;
+        skipWhitespace(text, pos);
+        if (!scanJsonValue(text, pos, &field)) return false;
+        if (obj->fieldCount < MAX_JSON_FIELDS) obj->fields[obj->fieldCount++] = field;
+        
+        skipWhitespace(text, pos);
+        if (pos >= text.length()) return false;
+        if (text[pos] == '}') return true;
+        if (text[pos] != ',') return false;
+        pos++;
+        skipWhitespace(text, pos);
+    }
+    return false;
+}
+
+const JsonField* findJsonField(const JsonObject* obj, string_view key) {
+    for (int i = 0; i < obj->fieldCount; i++)
+        if (obj->fields[i].key == key) return &obj->fields[i];
+    return nullptr;
+}
+
+void appendUtf8(string& out, unsigned int cp) {
+    if (cp < 0x80) {
+        out += (char)cp;
+    } else if (cp < 0x800) {
+        out += (char)(0xC0 | (cp >> 6));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += (char)(0xE0 | (cp >> 12));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else {
+        out += (char)(0xF0 | (cp >> 18));
+        out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+// Four hex digits at text[pos]; -1 if malformed
+int parseHex4(string_view text, size_t pos) {
+    if (pos + 4 > text.length()) return -1;
+    int value = 0;
+    for (size_t i = pos; i < pos + 4; i++) {
+        char c = text[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9') value |= c - '0';
+        else if (c >= 'a' && c <= 'f') value |= c - 'a' + 10;
+        else if (c >= 'A' && c <= 'F') value |= c - 'A' + 10;
+        else return -1;
+    }
+    return value;
+}
+
+// Decode JSON string escapes, including \uXXXX and surrogate pairs, into UTF-8;
+// a lone surrogate becomes U+FFFD
+string unescapeJson(string_view raw) {
+    string out;
+    out.reserve(raw.length());
+    for (size_t i = 0; i < raw.length(); i++) {
+        if (raw[i] != '\\' || i + 1 >= raw.length()) {
+            out += raw[i];
+            continue;
+        }
+        char e = raw[++i];
+        switch (e) {
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                int cp = parseHex4(raw, i + 1);
+                if (cp < 0) { out += e; break; }
+                i += 4;
+                if (cp >= 0xD800 && cp <= 0xDBFF && i + 2 < raw.length() && raw[i + 1] == '\\' && raw[i + 2] == 'u') {
+                    int low = parseHex4(raw, i + 3);
+                    if (low >= 0xDC00 && low <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        i += 6;
+                    }
+                }
+                if (cp >= 0xD800 && cp <= 0xDFFF) cp = 0xFFFD;  // unpaired surrogate has no UTF-8 form
+                appendUtf8(out, cp);
+                break;
+            }
+            default: out += e;  // \" \\ \/
+        }
+    }
+    return out;
+}
+
+// Field value as text: unescaped for strings, literal text for numbers/bools, "" if absent or null
+string jsonString(const JsonObject* obj, string_view key) {
+    const JsonField* field = findJsonField(obj, key);
+    if (field == nullptr || field->type == JSON_NULL) return "";
+    if (field->type == JSON_STRING) return unescapeJson(field->value);
+    return string(field->value);
+}
+
+// Escape a value for embedding inside a JSON string in a response
+string escapeJson(const string& str) {
+    string result;
+    result.reserve(str.length());
+    for (char c : str) {
+        switch (c) {
+            case '"': result += "\\\""; break;
+            case '\\': result += "\\\\"; break;
+            case '\n': result += "\\n"; break;
+            case '\r': result += "\\r"; break;
+            case '\t': result += "\\t"; break;
+            default:
+                if ((unsigned char)c < 0x20) {
+                    char hex[8];
+                    snprintf(hex, sizeof(hex), "\\u%04x", c);
+                    result += hex;
+                } else {
+                    result += c;
+                }
+        }
+    }
+    return result;
+}
+
+// Id index: open addressing with linear probing over a power-of-two table.
+// Ids are small, mostly sequential ints, so a multiplicative hash spreads
+// them before masking. The table doubles at 70% load, keeping lookups O(1).
+template <typename T>
+struct IdIndex {
+    struct Slot { int key; T* value; };
+    vector<Slot> slots;  // value == nullptr marks an empty slot
+    int count = 0;
+};
+
+inline unsigned int idSlot(int key, size_t mask) {
+    return (unsigned int)(((unsigned int)key * 2654435761u) & mask);
+}
+
+template <typename T>
+void idIndexGrow(IdIndex<T>& index) {
+    vector<typename IdIndex<T>::Slot> old;
+    old.swap(index.slots);
+    index.slots.assign(old.empty() ? 64 : old.size() * 2, { 0, nullptr });
+    size_t mask = index.slots.size() - 1;
+    for (size_t i = 0; i < old.size(); i++) {
+        if (old[i].value == nullptr) continue;
+        size_t pos = idSlot(old[i].key, mask);
+        while (index.slots[pos].value != nullptr) pos = (pos + 1) & mask;
+        index.slots[pos] = old[i];
+    }
+}
+
+// Insert or replace: the newest entry wins, as the old head-inserted list walk did
+template <typename T>
+void idIndexPut(IdIndex<T>& index, int key, T* value) {
+    if ((index.count + 1) * 10 > (int)index.slots.size() * 7) idIndexGrow(index);
+    size_t mask = index.slots.size() - 1;
+    size_t pos = idSlot(key, mask);
+    while (index.slots[pos].value != nullptr) {
+        if (index.slots[pos].key == key) {
+            index.slots[pos].value = value;
+            return;
+        }
+        pos = (pos + 1) & mask;
+    }
+    index.slots[pos] = { key, value };
+    index.count++;
+}
+
+template <typename T>
+T* idIndexGet(const IdIndex<T>& index, int key) {
+    if (index.slots.empty()) return nullptr;
+    size_t mask = index.slots.size() - 1;
+    size_t pos = idSlot(key, mask);
+    while (index.slots[pos].value != nullptr) {
+        if (index.slots[pos].key == key) return index.slots[pos].value;
+        pos = (pos + 1) & mask;
+    }
+    return nullptr;
+}
+
+IdIndex<User> userIdIndex;
+IdIndex<Crop> cropIdIndex;
+
+// Username table: Robin Hood open addressing. Each slot keeps the full hash
+// and its distance from the home slot; an insert that has probed further
+// than the resident takes its place, so probe lengths stay short and a miss
+// can stop as soon as it sees a slot closer to home than itself. The table
+// doubles at 80% load, so lookups stay O(1) however many users register.
+struct UserSlot {
+    unsigned int hash;
+    unsigned int dist;   // probe distance from hash & mask
+    User* user;          // nullptr marks an empty slot
+};
+
+struct UserTable {
+    vector<UserSlot> slots;
+    int count = 0;
+    long long totalProbe = 0;  // sum of slot distances, kept as entries move
+    int maxProbe = 0;          // distances only grow until the next rehash
+};
+
+struct UserTableStats {
+    int count;
+    int capacity;
+    double loadFactor;
+    double avgProbe;
+    int maxProbe;
+};
+
+UserTable userTable;
+
+void userTablePlace(UserTable& table, UserSlot entry) {
+    size_t mask = table.slots.size() - 1;
+    size_t pos = entry.hash & mask;
+    entry.dist = 0;
+    while (true) {
+        UserSlot& slot = table.slots[pos];
+        if (slot.user == nullptr) {
+            slot = entry;
+            table.maxProbe = max(table.maxProbe, (int)entry.dist);
+            return;
+        }
+        if (slot.dist < entry.dist) {
+            swap(slot, entry);
+            table.maxProbe = max(table.maxProbe, (int)slot.dist);
+        }
+        pos = (pos + 1) & mask;
+        entry.dist++;
+        table.totalProbe++;  // a swap keeps the sum, each step adds one
+    }
+}
+
+void userTableGrow(UserTable& table) {
+    vector<UserSlot> old;
+    old.swap(table.slots);
+    table.slots.assign(old.empty() ? 16 : old.size() * 2, { 0, 0, nullptr });
+    table.totalProbe = 0;
+    table.maxProbe = 0;
+    for (size_t i = 0; i < old.size(); i++) {
+        if (old[i].user != nullptr) userTablePlace(table, old[i]);
+    }
+}
+
+UserSlot* userTableFind(UserTable& table, unsigned int hash, const string& username) {
+    if (table.slots.empty()) return nullptr;
+    size_t mask = table.slots.size() - 1;
+    size_t pos = hash & mask;
+    for (unsigned int dist = 0; ; dist++) {
+        UserSlot& slot = table.slots[pos];
+        if (slot.user == nullptr || slot.dist < dist) return nullptr;
+        if (slot.hash == hash && slot.user->username == username) return &slot;
+        pos = (pos + 1) & mask;
+    }
+}
+
+// O(1): the probe totals are maintained by userTablePlace
+UserTableStats getUserTableStats() {
+    UserTableStats stats = { userTable.count, (int)userTable.slots.size(), 0.0, 0.0, userTable.maxProbe };
+    if (stats.capacity > 0) stats.loadFactor = (double)stats.count / stats.capacity;
+    if (stats.count > 0) stats.avgProbe = (double)userTable.totalProbe / stats.count;
+    return stats;
+}
+
 // User management
 void insertUser(User* newUser) {
-    int idx = hashUsername(newUser->username);
-    newUser->nextInBucket = userHashTable[idx];
-    userHashTable[idx] = newUser;
+    unsigned int hash = hashUsername(newUser->username);
+    UserSlot* existing = userTableFind(userTable, hash, newUser->username);
+    if (existing != nullptr) {
+        existing->user = newUser;  // newest registration wins, as with the old chain head
+    } else {
+        if ((userTable.count + 1) * 10 > (int)userTable.slots.size() * 8) userTableGrow(userTable);
+        userTablePlace(userTable, { hash, 0, newUser });
+        userTable.count++;
+    }
 
     newUser->nextInList = userListHead;
     userListHead = newUser;
+    idIndexPut(userIdIndex, newUser->userId, newUser);
+    userIds.observe(newUser->userId);
     userCount++;
 }
 
 User* findUserByUsername(string username) {
-    int idx = hashUsername(username);
-    User* curr = userHashTable[idx];
-    while (curr != nullptr) {
-        if (curr->username == username) return curr;
-        curr = curr->nextInBucket;
-    }
-    return nullptr;
+    UserSlot* slot = userTableFind(userTable, hashUsername(username), username);
+    return (slot != nullptr) ? slot->user : nullptr;
 }
 
 User* findUserById(int userId) {
-    User* curr = userListHead;
-    while (curr != nullptr) {
-        if (curr->userId == userId) return curr;
-        curr = curr->nextInList;
-    }
-    return nullptr;
+    return idIndexGet(userIdIndex, userId);
 }
 
 // Crop BST management
+// AVL-balanced price index: equal prices go right, and rotations keep the
+// in-order sequence, so listings stay sorted by price (ties in insertion
+// order) while the height stays O(log n) even for price-sorted input.
+int cropHeight(Crop* node) {
+    return (node == nullptr) ? 0 : node->height;
+}
+
+void updateCropHeight(Crop* node) {
+    int lh = cropHeight(node->left), rh = cropHeight(node->right);
+    node->height = 1 + ((lh > rh) ? lh : rh);
+}
+
+Crop* rotateCropRight(Crop* node) {
+    Crop* pivot = node->left;
+    node->left = pivot->right;
+    pivot->right = node;
+    updateCropHeight(node);
+    updateCropHeight(pivot);
+    return pivot;
+}
+
+Crop* rotateCropLeft(Crop* node) {
+    Crop* pivot = node->right;
+    node->right = pivot->left;
+    pivot->left = node;
+    updateCropHeight(node);
+    updateCropHeight(pivot);
+    return pivot;
+}
+
+Crop* rebalanceCrop(Crop* node) {
+    updateCropHeight(node);
+    int balance = cropHeight(node->left) - cropHeight(node->right);
+    if (balance > 1) {
+        if (cropHeight(node->left->left) < cropHeight(node->left->right))
+            node->left = rotateCropLeft(node->left);
+        return rotateCropRight(node);
+    }
+    if (balance < -1) {
+        if (cropHeight(node->right->right) < cropHeight(node->right->left))
+            node->right = rotateCropRight(node->right);
+        return rotateCropLeft(node);
+    }
+    return node;
+}
+
 Crop* insertCropBST(Crop* root, Crop* newCrop) {
-    if (root == nullptr) return newCrop;
+    if (root == nullptr) {
+        newCrop->left = newCrop->right = nullptr;
+        newCrop->height = 1;
+        return newCrop;
+    }
     if (newCrop->pricePerKg < root->pricePerKg)
         root->left = insertCropBST(root->left, newCrop);
     else
         root->right = insertCropBST(root->right, newCrop);
-    return root;
+    return rebalanceCrop(root);
 }
 
-void getCropsJSON(Crop* root, stringstream& ss, bool& first) {
-    if (root == nullptr) return;
-    getCropsJSON(root->left, ss, first);
-    if (root->available) {
-        if (!first) ss << ",";
-        first = false;
-        User* farmer = findUserById(root->farmerId);
-        string farmerName = (farmer != nullptr) ? farmer->username : "Unknown";
-        ss << "{\"id\":" << root->cropId 
-           << ",\"type\":\"" << root->cropType << "\""
-           << ",\"quantity\":" << root->quantity
-           << ",\"quality\":\"" << root->quality << "\""
-           << ",\"price\":" << root->pricePerKg
-           << ",\"farmer\":\"" << farmerName << "\""
-           << ",\"date\":\"" << formatDate(root->dateAdded) << "\"}";
+// Add a crop to the price BST and the id index together so the two never drift.
+// Listings only see it once the caller runs publishCropInsert() (or publishCrops()).
+void insertCrop(Crop* newCrop) {
+    cropBSTRoot = insertCropBST(cropBSTRoot, newCrop);
+    idIndexPut(cropIdIndex, newCrop->cropId, newCrop);
+    cropIds.observe(newCrop->cropId);
+    cropCount++;
+}
+
+// Listing filters taken from the /crops query string
+struct CropFilter {
+    string type;   // case-insensitive crop type, empty for any
+    int maxPrice;  // -1 for no limit
+};
+
+// O(1) through the id index; the BST is ordered by price, not id
+Crop* findCropById(int cropId) {
+    return idIndexGet(cropIdIndex, cropId);
+}
+
+void writeCropJSON(Crop* crop, const User* farmer, string& out) {
+    out += "{\"id\":" + to_string(crop->cropId);
+    out += ",\"type\":\"" + escapeJson(crop->cropType) + "\"";
+    out += ",\"quantity\":" + to_string(crop->quantity);
+    out += ",\"quality\":\"" + escapeJson(crop->quality) + "\"";
+    out += ",\"price\":" + to_string(crop->pricePerKg);
+    out += ",\"farmer\":\"" + escapeJson(farmer != nullptr ? farmer->username : "Unknown") + "\"";
+    out += ",\"date\":\"" + formatDate(crop->dateAdded) + "\"}";
+}
+
+bool cropMatches(Crop* crop, const CropFilter& filter) {
+    if (!crop->available) return false;
+    if (filter.maxPrice >= 0 && crop->pricePerKg > filter.maxPrice) return false;
+    if (filter.type.empty()) return true;
+    if (filter.type.length() != crop->cropType.length()) return false;
+    for (size_t i = 0; i < filter.type.length(); i++)
+        if (tolower((unsigned char)filter.type[i]) != tolower((unsigned char)crop->cropType[i])) return false;
+    return true;
+}
+
+/* ==================== READ SNAPSHOTS ====================
+ * /users, /status and /crops never take a lock. Writers build an
+ * immutable snapshot of what those endpoints show and publish it with one
+ * atomic pointer swap; readers load the pointer and walk it while the
+ * writer moves on.
+ *
+ * Old snapshots are reclaimed by epoch. A reader copies the global epoch
+ * into its own slot (one cache line per thread, so readers never write
+ * to shared memory) for as long as it holds a snapshot. Publishing stamps
+ * the replaced snapshot with the current epoch and advances it; a retired
+ * snapshot is freed once every busy slot shows a later epoch. A /crops
+ * stream outlives its handler, so it also pins its snapshot with a holder
+ * count that keeps it off the free list until the stream ends.
+ */
+
+// The user list is only ever head-inserted and its nodes never change, so
+// a snapshot is just the head at publish time: O(1) per registration.
+struct UserSnapshot {
+    User* head;
+    int count;
+    UserTableStats table;
+    atomic<int> holders{0};  // unused: user readers never outlive their guard
+};
+
+// Crops in price order with the farmer resolved, cut into pages that
+// consecutive snapshots share. Publishing one new crop copies the page it
+// lands in and the page table, not the whole listing; pages are never
+// modified once published, so readers need nothing beyond the epoch.
+const size_t CROP_PAGE_SIZE = 512;
+
+struct CropListing {
+    Crop* crop;
+    const User* farmer;  // nullptr until the farmer registers
+};
+
+typedef vector<CropListing> CropPage;
+
+struct CropSnapshot {
+    vector<shared_ptr<const CropPage>> pages;  // refcounts only change on the writer side
+    size_t count = 0;
+    vector<int> unresolvedFarmers;  // sorted ids behind the nullptr farmers
+    atomic<int> holders{0};
+};
+
+template <typename T>
+struct SnapshotCell {
+    atomic<T*> current{nullptr};
+    vector<pair<uint64_t, T*>> retired;  // writer side: guarded by the collection's lock
+};
+
+SnapshotCell<UserSnapshot> userSnapshot;  // published under usersLock
+SnapshotCell<CropSnapshot> cropSnapshot;  // published under cropsLock
+
+const int MAX_READER_SLOTS = 1024;
+
+struct alignas(64) ReaderSlot {
+    atomic<uint64_t> epoch{0};  // 0 while the thread holds no snapshot
+    atomic<bool> taken{false};
+};
+
+ReaderSlot readerSlots[MAX_READER_SLOTS];
+atomic<int> readerSlotsUsed{0};  // high-water mark, so publishers scan only claimed slots
+atomic<uint64_t> globalEpoch{1};
+
+// Claimed on a thread's first read and handed back when the thread exits
+struct ReaderRegistration {
+    ReaderSlot* slot = nullptr;
+    
+    ReaderRegistration() {
+        for (int i = 0; i < MAX_READER_SLOTS && slot == nullptr; i++) {
+            bool expected = false;
+            if (readerSlots[i].taken.compare_exchange_strong(expected, true)) slot = &readerSlots[i];
+        }
+        int used = readerSlotsUsed.load();
+        int mine = (slot != nullptr) ? (int)(slot - readerSlots) + 1 : 0;
+        while (used < mine && !readerSlotsUsed.compare_exchange_weak(used, mine)) {}
+    }
+    ~ReaderRegistration() {
+        if (slot != nullptr) slot->taken.store(false);
+    }
+};
+
+thread_local ReaderRegistration readerRegistration;
+
+// Scope in which snapshots loaded through it stay alive. Without a free
+// slot (more than MAX_READER_SLOTS live threads) it falls back to the
+// shared locks, which keep publishers, and so reclamation, out instead.
+// Guards do not nest: one per handler.
+struct SnapshotReadGuard {
+    ReaderSlot* slot;
+    shared_lock<shared_mutex> crops;
+    shared_lock<shared_mutex> users;
+    
+    SnapshotReadGuard() : slot(readerRegistration.slot) {
+        if (slot != nullptr) {
+            slot->epoch.store(globalEpoch.load());
+        } else {
+            crops = shared_lock<shared_mutex>(cropsLock);
+            users = shared_lock<shared_mutex>(usersLock);
+        }
+    }
+    ~SnapshotReadGuard() {
+        if (slot != nullptr) slot->epoch.store(0);
     }
-    getCropsJSON(root->right, ss, first);
+    
+    template <typename T>
+    T* load(SnapshotCell<T>& cell) { return cell.current.load(); }
+};
+
+uint64_t oldestReaderEpoch() {
+    uint64_t oldest = UINT64_MAX;
+    int used = readerSlotsUsed.load();
+    for (int i = 0; i < used; i++) {
+        uint64_t epoch = readerSlots[i].epoch.load();
+        if (epoch != 0 && epoch < oldest) oldest = epoch;
+    }
+    return oldest;
 }
 
-// JSON parsing helper
-string extractJsonValue(const string& json, const string& key) {
-    size_t keyPos = json.find("\"" + key + "\"");
-    if (keyPos == string::npos) return "";
+// Caller holds the cell's collection lock exclusively
+template <typename T>
+void publishSnapshot(SnapshotCell<T>& cell, T* next) {
+    T* old = cell.current.exchange(next);
+    if (old != nullptr) cell.retired.push_back({ globalEpoch.fetch_add(1), old });
     
-    size_t colonPos = json.find(":", keyPos);
-    if (colonPos == string::npos) return "";
+    uint64_t oldest = oldestReaderEpoch();
+    size_t kept = 0;
+    for (size_t i = 0; i < cell.retired.size(); i++) {
+        if (cell.retired[i].first < oldest && cell.retired[i].second->holders.load() == 0)
+            delete cell.retired[i].second;
+        else
+            cell.retired[kept++] = cell.retired[i];
+    }
+    cell.retired.resize(kept);
+}
+
+// Call with usersLock held exclusively, after every insertUser
+void publishUsers() {
+    UserSnapshot* next = new UserSnapshot;
+    next->head = userListHead;
+    next->count = userCount;
+    next->table = getUserTableStats();
+    publishSnapshot(userSnapshot, next);
+}
+
+// Full rebuild from the price tree, O(crops): after a bulk insert, or when
+// a farmer the listing was waiting for registers. Call with cropsLock held
+// exclusively.
+void publishCrops() {
+    CropSnapshot* next = new CropSnapshot;
+    shared_lock<shared_mutex> users(usersLock);
+    shared_ptr<CropPage> page;
+    vector<Crop*> stack;
+    Crop* node = cropBSTRoot;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
+        }
+        Crop* crop = stack.back();
+        stack.pop_back();
+        User* farmer = findUserById(crop->farmerId);
+        if (farmer == nullptr) next->unresolvedFarmers.push_back(crop->farmerId);
+        if (page == nullptr || page->size() == CROP_PAGE_SIZE) {
+            page = make_shared<CropPage>();
+            page->reserve(CROP_PAGE_SIZE);
+            next->pages.push_back(page);
+        }
+        page->push_back({ crop, farmer });
+        next->count++;
+        node = crop->right;
+    }
+    sort(next->unresolvedFarmers.begin(), next->unresolvedFarmers.end());
+    next->unresolvedFarmers.erase(unique(next->unresolvedFarmers.begin(), next->unresolvedFarmers.end()),
+                                  next->unresolvedFarmers.end());
+    publishSnapshot(cropSnapshot, next);
+}
+
+// Publish one crop just added with insertCrop on top of the current
+// snapshot: O(pages + CROP_PAGE_SIZE) instead of a rebuild. Call with
+// cropsLock held exclusively, once per insertCrop.
+void publishCropInsert(Crop* crop) {
+    CropSnapshot* current = cropSnapshot.current.load();
+    if (current == nullptr) {
+        publishCrops();
+        return;
+    }
+    CropSnapshot* next = new CropSnapshot;
+    next->pages = current->pages;
+    next->count = current->count + 1;
+    next->unresolvedFarmers = current->unresolvedFarmers;
+    User* farmer;
+    {
+        shared_lock<shared_mutex> users(usersLock);
+        farmer = findUserById(crop->farmerId);
+    }
+    if (farmer == nullptr) {
+        auto at = lower_bound(next->unresolvedFarmers.begin(), next->unresolvedFarmers.end(), crop->farmerId);
+        if (at == next->unresolvedFarmers.end() || *at != crop->farmerId) next->unresolvedFarmers.insert(at, crop->farmerId);
+    }
     
-    size_t valueStart = json.find("\"", colonPos);
-    if (valueStart == string::npos) return "";
+    // Equal prices go after the ones already listed, as in the tree: the
+    // first page holding a pricier crop, or the last page
+    int price = crop->pricePerKg;
+    auto pricier = [](int p, const CropListing& listing) { return p < listing.crop->pricePerKg; };
+    size_t p = partition_point(next->pages.begin(), next->pages.end(), [price](const shared_ptr<const CropPage>& pg) {
+        return pg->back().crop->pricePerKg <= price;
+    }) - next->pages.begin();
+    if (p == next->pages.size() && p > 0) p--;
+    shared_ptr<CropPage> page = (p < next->pages.size()) ? make_shared<CropPage>(*next->pages[p]) : make_shared<CropPage>();
+    page->insert(upper_bound(page->begin(), page->end(), price, pricier), { crop, farmer });
+    if (p == next->pages.size()) {
+        next->pages.push_back(page);
+    } else if (page->size() >= 2 * CROP_PAGE_SIZE) {
+        auto half = make_shared<CropPage>(page->begin() + CROP_PAGE_SIZE, page->end());
+        page->resize(CROP_PAGE_SIZE);
+        next->pages[p] = page;
+        next->pages.insert(next->pages.begin() + p + 1, half);
+    } else {
+        next->pages[p] = page;
+    }
+    publishSnapshot(cropSnapshot, next);
+}
+
+// True when a published crop listing still waits for this farmer to register
+bool cropsAwaitFarmer(int userId) {
+    SnapshotReadGuard guard;
+    CropSnapshot* crops = guard.load(cropSnapshot);
+    return crops != nullptr && binary_search(crops->unresolvedFarmers.begin(), crops->unresolvedFarmers.end(), userId);
+}
+
+/* ==================== STREAMED RESPONSES ====================
+ * Large listings are produced piece by piece instead of as one string.
+ * A BodyProducer appends roughly STREAM_CHUNK_SIZE bytes per call; the
+ * connection frames each piece with Transfer-Encoding: chunked into its
+ * reusable output buffer and only asks for more once that has drained,
+ * so time-to-first-byte and per-connection memory stay flat however
+ * many crops are listed.
+ */
+
+const size_t STREAM_CHUNK_SIZE = 16 * 1024;
+
+struct BodyProducer {
+    virtual ~BodyProducer() {}
+    // Append the next piece of the body to out; false once the body is complete
+    virtual bool produce(string& out) = 0;
+};
+
+// Walks one pinned crop snapshot, so a stream sees a single consistent
+// listing however many pieces it takes and never blocks a writer.
+struct CropStreamProducer : BodyProducer {
+    CropSnapshot* snapshot;  // pinned through holders; nullptr before the first publish
+    CropFilter filter;
+    size_t page;
+    size_t next;  // within page
+    bool started;
+    bool first;
     
-    size_t valueEnd = json.find("\"", valueStart + 1);
-    if (valueEnd == string::npos) return "";
+    CropStreamProducer(CropSnapshot* s, const CropFilter& f)
+        : snapshot(s), filter(f), page(0), next(0), started(false), first(true) {
+        if (snapshot != nullptr) snapshot->holders.fetch_add(1);
+    }
+    ~CropStreamProducer() {
+        if (snapshot != nullptr) snapshot->holders.fetch_sub(1);
+    }
     
-    return json.substr(valueStart + 1, valueEnd - valueStart - 1);
+    bool produce(string& out) override {
+        if (!started) {
+            out += "{\"crops\":[";
+            started = true;
+        }
+        size_t pageCount = (snapshot != nullptr) ? snapshot->pages.size() : 0;
+        size_t limit = out.length() + STREAM_CHUNK_SIZE;
+        while (page < pageCount && out.length() < limit) {
+            const CropPage& listings = *snapshot->pages[page];
+            if (next == listings.size()) {
+                page++;
+                next = 0;
+                continue;
+            }
+            const CropListing& listing = listings[next++];
+            // Sorted by price: everything after this is pricier, so stop once past the budget
+            if (filter.maxPrice >= 0 && listing.crop->pricePerKg > filter.maxPrice) {
+                page = pageCount;
+                break;
+            }
+            if (cropMatches(listing.crop, filter)) {
+                if (!first) out += ",";
+                first = false;
+                writeCropJSON(listing.crop, listing.farmer, out);
+            }
+        }
+        if (page < pageCount) return true;
+        out += "]}";
+        return false;
+    }
+};
+
+// Frame one piece of a streamed body as an HTTP chunk
+void appendChunk(string& out, const string& data) {
+    char size[20];
+    snprintf(size, sizeof(size), "%zx\r\n", data.length());
+    out += size;
+    out += data;
+    out += "\r\n";
+}
+
+// Pull the next piece from the producer into out (chunk-framed); false once the body is finished
+bool pumpStream(BodyProducer* producer, string& out, string& chunkBuf) {
+    chunkBuf.clear();
+    bool more = producer->produce(chunkBuf);
+    if (!chunkBuf.empty()) appendChunk(out, chunkBuf);
+    if (!more) out += "0\r\n\r\n";
+    return more;
 }
 
-// HTTP Request handler
-string handleRequest(string path, string method, string body) {
-    if (method == "OPTIONS") {
-        return "{\"status\": \"ok\"}";
+/* ==================== ROUTE TABLE ====================
+ * Routes are registered once at startup into a trie keyed on path
+ * segments. Literal segments are found through a hash map per node and a
+ * "{name}" segment matches any single segment, so dispatch costs one hash
+ * probe per path segment however many routes exist. Each node keeps one
+ * handler per method: a path that matches without a handler for the
+ * method answers 405 with an Allow header, an unknown path answers 404.
+ */
+
+const int MAX_ROUTE_PARAMS = 4;
+
+enum HttpMethod { METHOD_GET, METHOD_POST, METHOD_PUT, METHOD_DELETE, METHOD_COUNT, METHOD_UNKNOWN };
+const char* METHOD_NAMES[METHOD_COUNT] = { "GET", "POST", "PUT", "DELETE" };
+
+struct HttpResponse {
+    int status;
+    string body;
+    string headers;                 // extra header lines, each ending in \r\n
+    unique_ptr<BodyProducer> stream; // set instead of body for chunked responses
+};
+
+struct RouteContext {
+    string_view path;
+    string_view query;  // text after '?', still URL-encoded
+    string_view body;
+    string_view paramNames[MAX_ROUTE_PARAMS];
+    string_view paramValues[MAX_ROUTE_PARAMS];
+    int paramCount;
+};
+
+typedef HttpResponse (*RouteHandler)(const RouteContext& ctx);
+
+struct RouteNode {
+    unordered_map<string_view, RouteNode*> children;  // keys point into the registered patterns
+    RouteNode* paramChild;
+    string_view paramName;
+    RouteHandler handlers[METHOD_COUNT];
+};
+
+RouteNode* newRouteNode() {
+    RouteNode* node = new RouteNode;
+    node->paramChild = nullptr;
+    for (int i = 0; i < METHOD_COUNT; i++) node->handlers[i] = nullptr;
+    return node;
+}
+
+RouteNode* routeRoot = newRouteNode();
+
+HttpMethod parseMethod(string_view method) {
+    for (int i = 0; i < METHOD_COUNT; i++)
+        if (method == METHOD_NAMES[i]) return (HttpMethod)i;
+    return METHOD_UNKNOWN;
+}
+
+// Next non-empty '/'-separated segment at or after pos; empty when the path is exhausted
+string_view nextSegment(string_view path, size_t& pos) {
+    while (pos < path.length() && path[pos] == '/') pos++;
+    size_t start = pos;
+    while (pos < path.length() && path[pos] != '/') pos++;
+    return path.substr(start, pos - start);
+}
+
+// Patterns must outlive the table (string literals); "{name}" segments capture a parameter
+void addRoute(HttpMethod method, string_view pattern, RouteHandler handler) {
+    RouteNode* node = routeRoot;
+    size_t pos = 0;
+    string_view segment;
+    while (!(segment = nextSegment(pattern, pos)).empty()) {
+        if (segment.front() == '{' && segment.back() == '}') {
+            if (node->paramChild == nullptr) {
+                node->paramChild = newRouteNode();
+                node->paramChild->paramName = segment.substr(1, segment.length() - 2);
+            }
+            node = node->paramChild;
+        } else {
+            RouteNode*& child = node->children[segment];
+            if (child == nullptr) child = newRouteNode();
+            node = child;
+        }
     }
+    node->handlers[method] = handler;
+}
+
+// Literal segments win over parameters; backtracks if the literal branch dead-ends
+RouteNode* matchRoute(RouteNode* node, string_view path, size_t pos, RouteContext* ctx) {
+    string_view segment = nextSegment(path, pos);
+    if (segment.empty()) return node;
     
-    // Registration endpoint
-    if (method == "POST" && path == "/register") {
-        string username = extractJsonValue(body, "username");
-        string password = extractJsonValue(body, "password");
-        string role = extractJsonValue(body, "role");
-        string email = extractJsonValue(body, "email");
-        string phone = extractJsonValue(body, "phone");
-        
-        if (username.empty() || password.empty()) {
-            return "{\"success\": false, \"message\": \"Username and password are required\"}";
+    auto it = node->children.find(segment);
+    if (it != node->children.end()) {
+        RouteNode* found = matchRoute(it->second, path, pos, ctx);
+        if (found != nullptr) return found;
+    }
+    if (node->paramChild != nullptr && ctx->paramCount < MAX_ROUTE_PARAMS) {
+        int slot = ctx->paramCount++;
+        ctx->paramNames[slot] = node->paramChild->paramName;
+        ctx->paramValues[slot] = segment;
+        RouteNode* found = matchRoute(node->paramChild, path, pos, ctx);
+        if (found != nullptr) return found;
+        ctx->paramCount--;
+    }
+    return nullptr;
+}
+
+string_view routeParam(const RouteContext& ctx, string_view name) {
+    for (int i = 0; i < ctx.paramCount; i++)
+        if (ctx.paramNames[i] == name) return ctx.paramValues[i];
+    return string_view();
+}
+
+string urlDecode(string_view text) {
+    string out;
+    out.reserve(text.length());
+    for (size_t i = 0; i < text.length(); i++) {
+        if (text[i] == '+') {
+            out += ' ';
+        } else if (text[i] == '%' && i + 2 < text.length() && isxdigit((unsigned char)text[i + 1]) && isxdigit((unsigned char)text[i + 2])) {
+            out += (char)stoi(string(text.substr(i + 1, 2)), nullptr, 16);
+            i += 2;
+        } else {
+            out += text[i];
         }
-        
+    }
+    return out;
+}
+
+// Decoded value of ?name=value, or "" when the parameter is absent
+string queryParam(const RouteContext& ctx, string_view name) {
+    size_t pos = 0;
+    while (pos < ctx.query.length()) {
+        size_t end = ctx.query.find('&', pos);
+        if (end == string_view::npos) end = ctx.query.length();
+        string_view pair = ctx.query.substr(pos, end - pos);
+        size_t eq = pair.find('=');
+        if (pair.substr(0, eq) == name)
+            return eq == string_view::npos ? "" : urlDecode(pair.substr(eq + 1));
+        pos = end + 1;
+    }
+    return "";
+}
+
+// Strict non-negative integer parse for path parameters; -1 when invalid
+int parseIdParam(string_view text) {
+    if (text.empty() || text.length() > 9) return -1;
+    int value = 0;
+    for (char c : text) {
+        if (c < '0' || c > '9') return -1;
+        value = value * 10 + (c - '0');
+    }
+    return value;
+}
+
+HttpResponse jsonResponse(const string& body) {
+    return { 200, body, "", nullptr };
+}
+
+HttpResponse errorResponse(int status, const string& message) {
+    return { status, "{\"success\": false, \"message\": \"" + message + "\"}", "", nullptr };
+}
+
+HttpResponse dispatchRequest(string_view method, string_view target, string_view body) {
+    RouteContext ctx;
+    size_t queryStart = target.find('?');
+    ctx.path = target.substr(0, queryStart);
+    ctx.query = (queryStart == string_view::npos) ? string_view() : target.substr(queryStart + 1);
+    ctx.body = body;
+    ctx.paramCount = 0;
+    
+    RouteNode* node = matchRoute(routeRoot, ctx.path, 0, &ctx);
+    bool anyHandler = false;
+    for (int i = 0; node != nullptr && i < METHOD_COUNT; i++)
+        anyHandler = anyHandler || node->handlers[i] != nullptr;
+    if (!anyHandler) return errorResponse(404, "Not Found");
+    
+    HttpMethod m = parseMethod(method);
+    if (m == METHOD_UNKNOWN) return errorResponse(501, "Not Implemented");
+    if (node->handlers[m] == nullptr) {
+        string allow;
+        for (int i = 0; i < METHOD_COUNT; i++) {
+            if (node->handlers[i] == nullptr) continue;
+            if (!allow.empty()) allow += ", ";
+            allow += METHOD_NAMES[i];
+        }
+        HttpResponse r = errorResponse(405, "Method Not Allowed");
+        r.headers = "Allow: " + allow + ", OPTIONS\r\n";
+        return r;
+    }
+    return node->handlers[m](ctx);
+}
+
+/* ==================== ROUTE HANDLERS ==================== */
+
+HttpResponse handleRoot(const RouteContext&) {
+    return jsonResponse("{\"status\": \"ok\", \"message\": \"AgriConnect Backend Server\"}");
+}
+
+// Registration endpoint
+HttpResponse handleRegister(const RouteContext& ctx) {
+    JsonObject json;
+    parseJsonObject(ctx.body, &json);
+    string username = jsonString(&json, "username");
+    string password = jsonString(&json, "password");
+    string role = jsonString(&json, "role");
+    string email = jsonString(&json, "email");
+    string phone = jsonString(&json, "phone");
+    
+    if (username.empty() || password.empty()) {
+        return jsonResponse("{\"success\": false, \"message\": \"Username and password are required\"}");
+    }
+    
+    User* newUser = new User;
+    newUser->username = username;
+    newUser->password = password;
+    newUser->role = role.empty() ? "farmer" : role;
+    newUser->email = email;
+    newUser->phone = phone;
+    newUser->active = true;
+    newUser->nextInList = nullptr;
+    
+    {
+        // Check and insert under one lock so two requests cannot claim the same name
+        unique_lock<shared_mutex> lock(usersLock);
         if (findUserByUsername(username) != nullptr) {
-            return "{\"success\": false, \"message\": \"Username already exists. Please choose another.\"}";
+            delete newUser;
+            return jsonResponse("{\"success\": false, \"message\": \"Username already exists. Please choose another.\"}");
         }
-        
-        User* newUser = new User;
-        newUser->userId = hashID(username + to_string(userCount));
-        newUser->username = username;
-        newUser->password = password;
-        newUser->role = role.empty() ? "farmer" : role;
-        newUser->email = email;
-        newUser->phone = phone;
-        newUser->active = true;
-        newUser->nextInBucket = nullptr;
-        newUser->nextInList = nullptr;
-        
+        newUser->userId = userIds.next();
         insertUser(newUser);
-        
-        cout << "[REGISTER] New user: " << username << " (" << newUser->role << ")\n";
-        
-        return "{\"success\": true, \"message\": \"Registration successful! You can now login.\", \"user\": {\"id\": " + 
-               to_string(newUser->userId) + ", \"username\": \"" + newUser->username + "\", \"role\": \"" + newUser->role + "\"}}";
+        publishUsers();
+    }
+    if (cropsAwaitFarmer(newUser->userId)) {
+        // Crop listings resolve farmer names when published; pick up this one
+        unique_lock<shared_mutex> lock(cropsLock);
+        publishCrops();
     }
     
-    // Login endpoint
-    if (method == "POST" && path == "/login") {
-        string username = extractJsonValue(body, "username");
-        string password = extractJsonValue(body, "password");
-        
-        if (username.empty() || password.empty()) {
-            return "{\"success\": false, \"message\": \"Username and password are required\"}";
-        }
-        
-        User* user = findUserByUsername(username);
-        if (user == nullptr) {
-            return "{\"success\": false, \"message\": \"User not found. Please register first!\"}";
+    cout << "[REGISTER] New user: " << username << " (" << newUser->role << ")\n";
+    
+    return jsonResponse("{\"success\": true, \"message\": \"Registration successful! You can now login.\", \"user\": {\"id\": " + 
+                        to_string(newUser->userId) + ", \"username\": \"" + escapeJson(newUser->username) + "\", \"role\": \"" + escapeJson(newUser->role) + "\"}}");
+}
+
+// Login endpoint
+HttpResponse handleLogin(const RouteContext& ctx) {
+    JsonObject json;
+    parseJsonObject(ctx.body, &json);
+    string username = jsonString(&json, "username");
+    string password = jsonString(&json, "password");
+    
+    if (username.empty() || password.empty()) {
+        return jsonResponse("{\"success\": false, \"message\": \"Username and password are required\"}");
+    }
+    
+    shared_lock<shared_mutex> lock(usersLock);
+    User* user = findUserByUsername(username);
+    if (user == nullptr) {
+        return jsonResponse("{\"success\": false, \"message\": \"User not found. Please register first!\"}");
+    }
+    
+    if (user->password != password) {
+        return jsonResponse("{\"success\": false, \"message\": \"Invalid password. Please try again.\"}");
+    }
+    
+    cout << "[LOGIN] User: " << username << " (" << user->role << ")\n";
+    
+    return jsonResponse("{\"success\": true, \"message\": \"Login successful!\", \"user\": {\"id\": " + 
+                        to_string(user->userId) + ", \"username\": \"" + escapeJson(user->username) + 
+                        "\", \"role\": \"" + escapeJson(user->role) + "\", \"email\": \"" + escapeJson(user->email) + "\"}}");
+}
+
+// Status endpoint
+HttpResponse handleStatus(const RouteContext&) {
+    SnapshotReadGuard guard;
+    UserSnapshot* users = guard.load(userSnapshot);
+    CropSnapshot* crops = guard.load(cropSnapshot);
+    UserTableStats table = (users != nullptr) ? users->table : UserTableStats{ 0, 0, 0.0, 0.0, 0 };
+    stringstream ss;
+    ss << fixed << setprecision(3)
+       << "{\"status\": \"ok\", \"message\": \"AgriConnect Server Running\", \"users\": " << ((users != nullptr) ? users->count : 0)
+       << ", \"crops\": " << ((crops != nullptr) ? crops->count : 0)
+       << ", \"userTable\": {\"capacity\": " << table.capacity
+       << ", \"loadFactor\": " << table.loadFactor
+       << ", \"avgProbe\": " << table.avgProbe
+       << ", \"maxProbe\": " << table.maxProbe << "}}";
+    return jsonResponse(ss.str());
+}
+
+// Get all users
+HttpResponse handleUsers(const RouteContext&) {
+    SnapshotReadGuard guard;
+    UserSnapshot* users = guard.load(userSnapshot);
+    stringstream ss;
+    ss << "{\"users\":[";
+    User* curr = (users != nullptr) ? users->head : nullptr;
+    bool first = true;
+    while (curr != nullptr) {
+        if (!first) ss << ",";
+        first = false;
+        ss << "{\"id\":" << curr->userId 
+           << ",\"username\":\"" << escapeJson(curr->username) << "\""
+           << ",\"role\":\"" << escapeJson(curr->role) << "\"}";
+        curr = curr->nextInList;
+    }
+    ss << "]}";
+    return jsonResponse(ss.str());
+}
+
+// Get all crops, optionally filtered with ?type=wheat&maxPrice=100
+HttpResponse handleCrops(const RouteContext& ctx) {
+    CropFilter filter;
+    filter.type = queryParam(ctx, "type");
+    string maxPrice = queryParam(ctx, "maxPrice");
+    filter.maxPrice = maxPrice.empty() ? -1 : atoi(maxPrice.c_str());
+    
+    HttpResponse response = jsonResponse("");
+    SnapshotReadGuard guard;
+    response.stream.reset(new CropStreamProducer(guard.load(cropSnapshot), filter));
+    return response;
+}
+
+// List a crop for a registered farmer: {"farmerId", "type", "quantity", "quality", "price"}
+HttpResponse handleAddCrop(const RouteContext& ctx) {
+    JsonObject json;
+    parseJsonObject(ctx.body, &json);
+    int farmerId = parseIdParam(jsonString(&json, "farmerId"));
+    string type = jsonString(&json, "type");
+    int quantity = parseIdParam(jsonString(&json, "quantity"));
+    int price = parseIdParam(jsonString(&json, "price"));
+    string quality = jsonString(&json, "quality");
+    
+    if (farmerId < 0 || type.empty() || quantity <= 0 || price < 0) {
+        return jsonResponse("{\"success\": false, \"message\": \"farmerId, type, a positive quantity and price are required\"}");
+    }
+    {
+        shared_lock<shared_mutex> users(usersLock);
+        User* farmer = findUserById(farmerId);
+        if (farmer == nullptr || farmer->role != "farmer") {
+            return jsonResponse("{\"success\": false, \"message\": \"Only a registered farmer can list crops\"}");
         }
-        
-        if (user->password != password) {
-            return "{\"success\": false, \"message\": \"Invalid password. Please try again.\"}";
+    }
+    
+    Crop* crop = new Crop;
+    crop->farmerId = farmerId;
+    crop->cropType = type;
+    crop->quantity = quantity;
+    crop->quality = quality.empty() ? "A" : quality;
+    crop->pricePerKg = price;
+    crop->available = true;
+    crop->dateAdded = getCurrentDate();
+    crop->left = crop->right = nullptr;
+    crop->height = 1;
+    {
+        unique_lock<shared_mutex> lock(cropsLock);
+        crop->cropId = cropIds.next();
+        insertCrop(crop);
+        publishCropInsert(crop);
+    }
+    
+    cout << "[CROP] Farmer " << farmerId << " listed " << type << " (id " << crop->cropId << ")\n";
+    
+    return jsonResponse("{\"success\": true, \"message\": \"Crop listed\", \"crop\": {\"id\": " + to_string(crop->cropId) + "}}");
+}
+
+// Get one crop by id
+HttpResponse handleCropById(const RouteContext& ctx) {
+    int cropId = parseIdParam(routeParam(ctx, "id"));
+    if (cropId < 0) return errorResponse(400, "Invalid crop id");
+    
+    shared_lock<shared_mutex> crops(cropsLock);
+    shared_lock<shared_mutex> users(usersLock);
+    Crop* crop = findCropById(cropId);
+    if (crop == nullptr) return errorResponse(404, "Crop not found");
+    
+    string body;
+    writeCropJSON(crop, findUserById(crop->farmerId), body);
+    return jsonResponse(body);
+}
+
+void registerRoutes() {
+    addRoute(METHOD_GET, "/", handleRoot);
+    addRoute(METHOD_POST, "/register", handleRegister);
+    addRoute(METHOD_POST, "/login", handleLogin);
+    addRoute(METHOD_GET, "/status", handleStatus);
+    addRoute(METHOD_GET, "/users", handleUsers);
+    addRoute(METHOD_GET, "/crops", handleCrops);
+    addRoute(METHOD_POST, "/crops", handleAddCrop);
+    addRoute(METHOD_GET, "/crops/{id}", handleCropById);
+}
+
+const char* statusText(int status) {
+    switch (status) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 405: return "Method Not Allowed";
+        case 413: return "Payload Too Large";
+        case 431: return "Request Header Fields Too Large";
+        case 501: return "Not Implemented";
+        case 505: return "HTTP Version Not Supported";
+        default: return "Internal Server Error";
+    }
+}
+
+// Status line and common headers; the caller adds the framing header and blank line
+string buildResponseHead(int status, bool keepAlive, const string& extraHeaders) {
+    return "HTTP/1.1 " + to_string(status) + " " + statusText(status) + "\r\n"
+           "Content-Type: application/json\r\n"
+           "Access-Control-Allow-Origin: *\r\n"
+           "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
+           "Access-Control-Allow-Headers: Content-Type\r\n"
+           + extraHeaders
+           + (keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n");
+}
+
+// Build a complete HTTP response around a JSON body
+string buildHttpResponse(int status, const string& jsonBody, bool keepAlive, const string& extraHeaders = "") {
+    return buildResponseHead(status, keepAlive, extraHeaders) +
+           "Content-Length: " + to_string(jsonBody.length()) + "\r\n"
+           "\r\n" + jsonBody;
+}
+
+string buildErrorResponse(int status) {
+    return buildHttpResponse(status, "{\"success\": false, \"message\": \"" + string(statusText(status)) + "\"}", false);
+}
+
+/* ==================== HTTP REQUEST PARSER ====================
+ * Incremental state machine over a connection's growing input buffer.
+ * The parser remembers where it stopped, so every byte is scanned once
+ * however the request is split across recv calls, and it records spans
+ * (offsets from the start of the request) instead of copying. When a
+ * request is complete the spans become string_views into the buffer,
+ * valid until the buffer is next modified.
+ */
+
+const size_t MAX_HEADER_BYTES = 16 * 1024;
+const size_t MAX_BODY_BYTES = 8 * 1024 * 1024;
+const int MAX_HEADERS = 32;
+
+enum ParseState { PARSE_REQUEST_LINE, PARSE_HEADERS, PARSE_BODY, PARSE_DONE, PARSE_ERROR };
+
+struct Span {
+    size_t offset;
+    size_t length;
+};
+
+struct HttpRequest {
+    string_view method;
+    string_view target;
+    string_view version;
+    string_view headerNames[MAX_HEADERS];
+    string_view headerValues[MAX_HEADERS];
+    int headerCount;
+    string_view body;
+    bool keepAlive;
+};
+
+struct HttpParser {
+    ParseState state;
+    size_t start;       // offset of the current request in the buffer
+    size_t lineStart;   // offset of the line being assembled
+    size_t scanPos;     // offset where the newline search resumes
+    Span method;
+    Span target;
+    Span version;
+    Span headerNames[MAX_HEADERS];
+    Span headerValues[MAX_HEADERS];
+    int headerCount;
+    size_t bodyOffset;  // relative to start
+    size_t contentLength;
+    int errorStatus;    // status to answer with once state == PARSE_ERROR
+};
+
+void initParser(HttpParser* p) {
+    p->state = PARSE_REQUEST_LINE;
+    p->start = p->lineStart = p->scanPos = 0;
+    p->headerCount = 0;
+    p->bodyOffset = 0;
+    p->contentLength = 0;
+    p->errorStatus = 0;
+}
+
+bool equalsIgnoreCase(string_view a, string_view b) {
+    if (a.length() != b.length()) return false;
+    for (size_t i = 0; i < a.length(); i++)
+        if (tolower((unsigned char)a[i]) != tolower((unsigned char)b[i])) return false;
+    return true;
+}
+
+string_view findHeader(const HttpRequest* req, string_view name) {
+    for (int i = 0; i < req->headerCount; i++)
+        if (equalsIgnoreCase(req->headerNames[i], name)) return req->headerValues[i];
+    return string_view();
+}
+
+ParseState parserFail(HttpParser* p, int status) {
+    p->state = PARSE_ERROR;
+    p->errorStatus = status;
+    return PARSE_ERROR;
+}
+
+// Span for buf[from, to) relative to the request start, trimmed of spaces and tabs
+Span makeSpan(const HttpParser* p, const string& buf, size_t from, size_t to) {
+    while (from < to && (buf[from] == ' ' || buf[from] == '\t')) from++;
+    while (to > from && (buf[to - 1] == ' ' || buf[to - 1] == '\t')) to--;
+    return { from - p->start, to - from };
+}
+
+string_view spanView(const string& buf, size_t start, Span s) {
+    return string_view(buf.data() + start + s.offset, s.length);
+}
+
+// Request line: METHOD SP TARGET SP HTTP/1.x
+bool parseRequestLine(HttpParser* p, const string& buf, size_t from, size_t to) {
+    size_t sp1 = buf.find(' ', from);
+    if (sp1 == string::npos || sp1 >= to) return false;
+    size_t sp2 = buf.find(' ', sp1 + 1);
+    if (sp2 == string::npos || sp2 >= to) return false;
+    p->method = makeSpan(p, buf, from, sp1);
+    p->target = makeSpan(p, buf, sp1 + 1, sp2);
+    p->version = makeSpan(p, buf, sp2 + 1, to);
+    return p->method.length > 0 && p->target.length > 0;
+}
+
+// Called on the blank line that ends the header block
+ParseState finishHeaders(HttpParser* p, const string& buf) {
+    HttpRequest probe;
+    probe.headerCount = p->headerCount;
+    for (int i = 0; i < p->headerCount; i++) {
+        probe.headerNames[i] = spanView(buf, p->start, p->headerNames[i]);
+        probe.headerValues[i] = spanView(buf, p->start, p->headerValues[i]);
+    }
+    if (!findHeader(&probe, "Transfer-Encoding").empty()) return parserFail(p, 501);
+    
+    string_view length = findHeader(&probe, "Content-Length");
+    p->contentLength = 0;
+    for (size_t i = 0; i < length.length(); i++) {
+        if (length[i] < '0' || length[i] > '9') return parserFail(p, 400);
+        p->contentLength = p->contentLength * 10 + (length[i] - '0');
+        if (p->contentLength > MAX_BODY_BYTES) return parserFail(p, 413);
+    }
+    p->bodyOffset = p->lineStart - p->start;
+    p->state = PARSE_BODY;
+    return PARSE_BODY;
+}
+
+// Advance over whatever is buffered. Returns PARSE_DONE with req filled in
+// once a whole request is available, PARSE_ERROR on a malformed or oversized
+// request, or the current state when more bytes are needed.
+ParseState parseRequest(HttpParser* p, const string& buf, HttpRequest* req) {
+    while (p->state == PARSE_REQUEST_LINE || p->state == PARSE_HEADERS) {
+        size_t newline = buf.find('\n', p->scanPos);
+        if (newline == string::npos) {
+            p->scanPos = buf.length();
+            if (buf.length() - p->start > MAX_HEADER_BYTES) return parserFail(p, 431);
+            return p->state;
         }
+        if (newline - p->start > MAX_HEADER_BYTES) return parserFail(p, 431);
         
-        cout << "[LOGIN] User: " << username << " (" << user->role << ")\n";
+        size_t from = p->lineStart;
+        size_t to = (newline > from && buf[newline - 1] == '\r') ? newline - 1 : newline;
+        p->lineStart = p->scanPos = newline + 1;
         
-        return "{\"success\": true, \"message\": \"Login successful!\", \"user\": {\"id\": " + 
-               to_string(user->userId) + ", \"username\": \"" + user->username + 
-               "\", \"role\": \"" + user->role + "\", \"email\": \"" + user->email + "\"}}";
+        if (p->state == PARSE_REQUEST_LINE) {
+            if (from == to) {  // tolerate blank lines between pipelined requests
+                p->start = p->lineStart;
+                continue;
+            }
+            if (!parseRequestLine(p, buf, from, to)) return parserFail(p, 400);
+            if (spanView(buf, p->start, p->version).substr(0, 7) != "HTTP/1.") return parserFail(p, 505);
+            p->state = PARSE_HEADERS;
+        } else if (from == to) {
+            if (finishHeaders(p, buf) == PARSE_ERROR) return PARSE_ERROR;
+        } else {
+            size_t colon = buf.find(':', from);
+            if (colon == string::npos || colon >= to || colon == from) return parserFail(p, 400);
+            if (p->headerCount == MAX_HEADERS) return parserFail(p, 431);
+            p->headerNames[p->headerCount] = makeSpan(p, buf, from, colon);
+            p->headerValues[p->headerCount] = makeSpan(p, buf, colon + 1, to);
+            p->headerCount++;
+        }
     }
     
-    // Status endpoint
-    if (method == "GET" && path == "/status") {
-        return "{\"status\": \"ok\", \"message\": \"AgriConnect Server Running\", \"users\": " + 
-               to_string(userCount) + ", \"crops\": " + to_string(cropCount) + "}";
-    }
+    if (p->state != PARSE_BODY) return p->state;
+    if (buf.length() - (p->start + p->bodyOffset) < p->contentLength) return PARSE_BODY;
     
-    // Get all users
-    if (method == "GET" && path == "/users") {
-        stringstream ss;
-        ss << "{\"users\":[";
-        User* curr = userListHead;
-        bool first = true;
-        while (curr != nullptr) {
-            if (!first) ss << ",";
-            first = false;
-            ss << "{\"id\":" << curr->userId 
-               << ",\"username\":\"" << curr->username << "\""
-               << ",\"role\":\"" << curr->role << "\"}";
-            curr = curr->nextInList;
-        }
-        ss << "]}";
-        return ss.str();
+    req->method = spanView(buf, p->start, p->method);
+    req->target = spanView(buf, p->start, p->target);
+    req->version = spanView(buf, p->start, p->version);
+    req->headerCount = p->headerCount;
+    for (int i = 0; i < p->headerCount; i++) {
+        req->headerNames[i] = spanView(buf, p->start, p->headerNames[i]);
+        req->headerValues[i] = spanView(buf, p->start, p->headerValues[i]);
     }
+    req->body = string_view(buf.data() + p->start + p->bodyOffset, p->contentLength);
+    
+    // HTTP/1.1 keeps the connection open unless asked not to; HTTP/1.0 only when asked
+    string_view connection = findHeader(req, "Connection");
+    if (!keepAliveEnabled) req->keepAlive = false;
+    else if (req->version == "HTTP/1.1") req->keepAlive = !equalsIgnoreCase(connection, "close");
+    else req->keepAlive = equalsIgnoreCase(connection, "keep-alive");
     
-    // Get all crops
-    if (method == "GET" && path == "/crops") {
-        stringstream ss;
-        ss << "{\"crops\":[";
-        bool first = true;
-        getCropsJSON(cropBSTRoot, ss, first);
-        ss << "]}";
-        return ss.str();
+    p->state = PARSE_DONE;
+    return PARSE_DONE;
+}
+
+// Step past the request just returned so the next pipelined one can be parsed
+void finishRequest(HttpParser* p) {
+    p->start += p->bodyOffset + p->contentLength;
+    p->lineStart = p->scanPos = p->start;
+    p->headerCount = 0;
+    p->bodyOffset = 0;
+    p->contentLength = 0;
+    p->state = PARSE_REQUEST_LINE;
+}
+
+// Drop bytes of requests already answered; spans are relative to start so they stay valid
+void compactBuffer(HttpParser* p, string& buf) {
+    if (p->start == 0) return;
+    buf.erase(0, p->start);
+    p->lineStart -= p->start;
+    p->scanPos -= p->start;
+    p->start = 0;
+}
+
+// Answer one parsed request: appends the response (or, for a streamed body,
+// just its head) to out and hands any body producer back through stream
+void processRequest(const HttpRequest& req, string& out, unique_ptr<BodyProducer>& stream) {
+    // Handle OPTIONS for CORS
+    if (req.method == "OPTIONS") {
+        out += "HTTP/1.1 200 OK\r\n"
+               "Access-Control-Allow-Origin: *\r\n"
+               "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
+               "Access-Control-Allow-Headers: Content-Type\r\n"
+               + string(req.keepAlive ? "Connection: keep-alive\r\n" : "Connection: close\r\n") +
+               "Content-Length: 0\r\n\r\n";
+        return;
     }
     
-    return "{\"status\": \"ok\", \"message\": \"AgriConnect Backend Server\"}";
+    HttpResponse response = dispatchRequest(req.method, req.target, req.body);
+    if (response.stream != nullptr && req.version != "HTTP/1.1") {
+        // HTTP/1.0 has no chunked encoding: drain the producer into a sized body
+        while (response.stream->produce(response.body)) {}
+        response.stream.reset();
+    }
+    if (response.stream == nullptr) {
+        out += buildHttpResponse(response.status, response.body, req.keepAlive, response.headers);
+        return;
+    }
+    out += buildResponseHead(response.status, req.keepAlive, response.headers) +
+           "Transfer-Encoding: chunked\r\n\r\n";
+    stream = move(response.stream);
+}
+
+// Responses leave in whole pieces, so Nagle only delays the last short
+// segment of a streamed body until the client's delayed ACK (~40 ms per
+// response on a keep-alive connection)
+void disableNagle(SOCKET s) {
+    int one = 1;
+    setsockopt(s, IPPROTO_TCP, TCP_NODELAY, (char*)&one, sizeof(one));
+}
+
+bool sendAll(SOCKET s, const string& data) {
+    size_t sent = 0;
+    while (sent < data.length()) {
+        int n = send(s, data.c_str() + sent, (int)(data.length() - sent), SEND_FLAGS);
+        if (n <= 0) return false;
+        sent += n;
+    }
+    return true;
 }
 
+// Per-connection request loop: answers pipelined requests in order until the
+// client closes, asks for Connection: close, or stays idle past the timeout
 void handleClient(SOCKET clientSocket) {
-    char buffer[BUFFER_SIZE] = {0};
-    int bytesReceived = recv(clientSocket, buffer, BUFFER_SIZE - 1, 0);
+#ifdef _WIN32
+    DWORD timeout = KEEP_ALIVE_TIMEOUT_SEC * 1000;
+#else
+    timeval timeout = { KEEP_ALIVE_TIMEOUT_SEC, 0 };
+#endif
+    setsockopt(clientSocket, SOL_SOCKET, SO_RCVTIMEO, (char*)&timeout, sizeof(timeout));
+    disableNagle(clientSocket);
     
-    if (bytesReceived > 0) {
-        string request(buffer);
+    string inBuf;
+    string responses;
+    string chunkBuf;
+    HttpParser parser;
+    HttpRequest request;
+    initParser(&parser);
+    bool open = true;
+    while (open) {
+        // Receive straight into the tail of the growing buffer
+        size_t used = inBuf.length();
+        inBuf.resize(used + BUFFER_SIZE);
+        int bytesReceived = recv(clientSocket, &inBuf[used], BUFFER_SIZE, 0);
+        if (bytesReceived <= 0) break;
+        inBuf.resize(used + bytesReceived);
         
-        // Parse request line
-        string method, path;
-        size_t pos = request.find(' ');
-        if (pos != string::npos) {
-            method = request.substr(0, pos);
-            size_t pos2 = request.find(' ', pos + 1);
-            if (pos2 != string::npos) {
-                path = request.substr(pos + 1, pos2 - pos - 1);
+        responses.clear();
+        ParseState state = PARSE_REQUEST_LINE;
+        bool sendFailed = false;
+        while (open && !sendFailed && (state = parseRequest(&parser, inBuf, &request)) == PARSE_DONE) {
+            open = request.keepAlive;
+            unique_ptr<BodyProducer> stream;
+            processRequest(request, responses, stream);
+            finishRequest(&parser);
+            
+            // Send streamed bodies chunk by chunk, reusing the same two buffers
+            bool more = stream != nullptr;
+            while (more && !sendFailed) {
+                more = pumpStream(stream.get(), responses, chunkBuf);
+                sendFailed = !sendAll(clientSocket, responses);
+                responses.clear();
+            }
+        }
+        if (sendFailed) break;
+        if (state == PARSE_ERROR) {
+            responses += buildErrorResponse(parser.errorStatus);
+            open = false;
+        }
+        if (!responses.empty() && !sendAll(clientSocket, responses)) break;
+        compactBuffer(&parser, inBuf);
+    }
+    
+    closesocket(clientSocket);
+}
+
+// Thread-per-connection accept loop (default mode)
+void runThreadPerConnection(SOCKET serverSocket) {
+    SOCKET clientSocket;
+    SOCKADDR_IN clientAddr;
+    socklen_t clientAddrLen = sizeof(clientAddr);
+    
+    while (true) {
+        clientSocket = accept(serverSocket, (SOCKADDR*)&clientAddr, &clientAddrLen);
+        if (clientSocket != INVALID_SOCKET) {
+            thread t(handleClient, clientSocket);
+            t.detach();
+        }
+    }
+}
+
+#ifdef __linux__
+/* ==================== EPOLL EVENT LOOP ====================
+ * One acceptor thread hands non-blocking client sockets round-robin to a
+ * fixed set of workers. Each worker owns an edge-triggered epoll instance
+ * and every connection registered on it, so connection state is never
+ * shared between threads. Memory is bounded by MAX_CONNECTIONS open sockets,
+ * each holding at most one request's headers and body plus
+ * MAX_OUTPUT_BACKLOG of unsent output.
+ *
+ * Each worker also keeps its connections on an LRU list ordered by last
+ * activity, so idle keep-alive connections are expired from the front in
+ * O(expired) on every epoll_wait tick.
+ */
+
+struct Connection {
+    SOCKET fd;
+    string inBuf;
+    HttpParser parser;
+    string outBuf;
+    size_t outOffset;
+    string chunkBuf;                  // reused for every piece of a streamed body
+    unique_ptr<BodyProducer> stream;  // body still being produced for the current response
+    bool closeAfterWrite;
+    bool inputClosed;                 // peer shut down its side; answer what it sent, then close
+    time_t lastActive;
+    Connection* lruPrev;
+    Connection* lruNext;
+};
+
+struct EpollWorker {
+    int epollFd;
+    int wakeFd;                     // eventfd the acceptor signals after queueing sockets
+    mutex pendingLock;
+    vector<SOCKET> pendingSockets;  // accepted, not yet adopted by this worker
+    Connection* lruHead;            // least recently active
+    Connection* lruTail;            // most recently active
+};
+
+atomic<int> openConnections(0);
+
+bool setNonBlocking(SOCKET fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags != -1 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) != -1;
+}
+
+void lruUnlink(EpollWorker* w, Connection* conn) {
+    if (conn->lruPrev != nullptr) conn->lruPrev->lruNext = conn->lruNext;
+    else w->lruHead = conn->lruNext;
+    if (conn->lruNext != nullptr) conn->lruNext->lruPrev = conn->lruPrev;
+    else w->lruTail = conn->lruPrev;
+    conn->lruPrev = conn->lruNext = nullptr;
+}
+
+void lruPushBack(EpollWorker* w, Connection* conn) {
+    conn->lruPrev = w->lruTail;
+    conn->lruNext = nullptr;
+    if (w->lruTail != nullptr) w->lruTail->lruNext = conn;
+    else w->lruHead = conn;
+    w->lruTail = conn;
+}
+
+void touchConnection(EpollWorker* w, Connection* conn) {
+    conn->lastActive = time(nullptr);
+    if (w->lruTail != conn) {
+        lruUnlink(w, conn);
+        lruPushBack(w, conn);
+    }
+}
+
+void closeConnection(EpollWorker* w, Connection* conn) {
+    lruUnlink(w, conn);
+    closesocket(conn->fd);  // closing the fd also removes it from the epoll set
+    delete conn;
+    openConnections--;
+}
+
+// Write as much pending output as the socket accepts; false if the connection was closed
+bool flushConnection(EpollWorker* w, Connection* conn) {
+    while (conn->outOffset < conn->outBuf.length()) {
+        ssize_t n = send(conn->fd, conn->outBuf.data() + conn->outOffset,
+                         conn->outBuf.length() - conn->outOffset, SEND_FLAGS);
+        if (n > 0) {
+            conn->outOffset += n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return true;  // wait for the next EPOLLOUT edge
+        } else {
+            closeConnection(w, conn);
+            return false;
+        }
+    }
+    conn->outBuf.clear();
+    conn->outOffset = 0;
+    if (conn->closeAfterWrite && conn->stream == nullptr) {
+        closeConnection(w, conn);
+        return false;
+    }
+    return true;
+}
+
+// Answer every complete request buffered on the connection, in arrival order.
+// Work only continues while the unsent backlog is small, so neither a client
+// that pipelines without reading nor a long streamed body can grow outBuf
+// without bound; the next EPOLLOUT edge resumes where this stopped.
+bool serviceConnection(EpollWorker* w, Connection* conn) {
+    HttpRequest request;
+    while (true) {
+        ParseState state = PARSE_REQUEST_LINE;
+        bool drained = false;  // every complete buffered request has been answered
+        while (conn->outBuf.length() - conn->outOffset < MAX_OUTPUT_BACKLOG) {
+            if (conn->stream != nullptr) {
+                // Finish the streamed body before answering the next pipelined request
+                if (!pumpStream(conn->stream.get(), conn->outBuf, conn->chunkBuf)) conn->stream.reset();
+                continue;
+            }
+            if (conn->closeAfterWrite) break;
+            state = parseRequest(&conn->parser, conn->inBuf, &request);
+            if (state != PARSE_DONE) {
+                drained = true;
+                break;
             }
+            processRequest(request, conn->outBuf, conn->stream);
+            if (!request.keepAlive) conn->closeAfterWrite = true;
+            finishRequest(&conn->parser);
         }
+        if (state == PARSE_ERROR) {
+            conn->outBuf += buildErrorResponse(conn->parser.errorStatus);
+            conn->closeAfterWrite = true;
+        } else if (drained && conn->inputClosed) {
+            conn->closeAfterWrite = true;  // nothing more can arrive
+        }
+        compactBuffer(&conn->parser, conn->inBuf);
+        if (!flushConnection(w, conn)) return false;
+        if (!conn->outBuf.empty()) return true;  // socket is full; resume on EPOLLOUT
+        if (conn->stream == nullptr && state != PARSE_DONE) return true;
+    }
+}
+
+// Drain the socket (edge-triggered) and answer whatever requests are now complete
+bool readFromConnection(EpollWorker* w, Connection* conn) {
+    while (true) {
+        // Receive straight into the tail of the growing buffer
+        size_t used = conn->inBuf.length();
+        conn->inBuf.resize(used + BUFFER_SIZE);
+        ssize_t n = recv(conn->fd, &conn->inBuf[used], BUFFER_SIZE, 0);
+        conn->inBuf.resize(used + (n > 0 ? n : 0));
+        if (n > 0) {
+            if (conn->closeAfterWrite) conn->inBuf.clear();  // nothing more will be answered
+            if (conn->inBuf.length() > MAX_HEADER_BYTES + MAX_BODY_BYTES) {
+                closeConnection(w, conn);
+                return false;
+            }
+        } else if (n == 0) {
+            // Half-close: requests already buffered still get their responses
+            conn->inputClosed = true;
+            break;
+        } else if (errno == EINTR) {
+            continue;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else {
+            closeConnection(w, conn);
+            return false;
+        }
+    }
+    return serviceConnection(w, conn);
+}
+
+// Register sockets queued by the acceptor with this worker's epoll set
+void adoptPendingSockets(EpollWorker* w) {
+    uint64_t counter;
+    while (read(w->wakeFd, &counter, sizeof(counter)) > 0) {}
+    
+    vector<SOCKET> sockets;
+    {
+        lock_guard<mutex> lock(w->pendingLock);
+        sockets.swap(w->pendingSockets);
+    }
+    for (SOCKET fd : sockets) {
+        Connection* conn = new Connection;
+        conn->fd = fd;
+        conn->outOffset = 0;
+        conn->closeAfterWrite = false;
+        conn->inputClosed = false;
+        initParser(&conn->parser);
+        conn->lruPrev = conn->lruNext = nullptr;
+        conn->lastActive = time(nullptr);
+        lruPushBack(w, conn);
+        disableNagle(fd);
         
-        // Handle OPTIONS for CORS
-        if (method == "OPTIONS") {
-            string response = "HTTP/1.1 200 OK\r\n"
-                             "Access-Control-Allow-Origin: *\r\n"
-                             "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
-                             "Access-Control-Allow-Headers: Content-Type\r\n"
-                             "Connection: close\r\n"
-                             "Content-Length: 0\r\n\r\n";
-            send(clientSocket, response.c_str(), response.length(), 0);
-            closesocket(clientSocket);
+        // Register for both directions once; edge-triggered so no re-arming is needed
+        epoll_event ev;
+        ev.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        ev.data.ptr = conn;
+        if (epoll_ctl(w->epollFd, EPOLL_CTL_ADD, fd, &ev) < 0)
+            closeConnection(w, conn);
+    }
+}
+
+void expireIdleConnections(EpollWorker* w) {
+    time_t cutoff = time(nullptr) - KEEP_ALIVE_TIMEOUT_SEC;
+    while (w->lruHead != nullptr && w->lruHead->lastActive <= cutoff)
+        closeConnection(w, w->lruHead);
+}
+
+void runEpollWorker(EpollWorker* w) {
+    epoll_event events[MAX_EPOLL_EVENTS];
+    while (true) {
+        int n = epoll_wait(w->epollFd, events, MAX_EPOLL_EVENTS, 1000);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            cerr << "epoll_wait failed: " << errno << "\n";
             return;
         }
-        
-        // Get body if POST
-        string body;
-        size_t bodyStart = request.find("\r\n\r\n");
-        if (bodyStart != string::npos) {
-            body = request.substr(bodyStart + 4);
+        for (int i = 0; i < n; i++) {
+            Connection* conn = (Connection*)events[i].data.ptr;
+            if (conn == nullptr) {
+                adoptPendingSockets(w);
+                continue;
+            }
+            if (events[i].events & (EPOLLERR | EPOLLHUP)) {
+                closeConnection(w, conn);
+                continue;
+            }
+            touchConnection(w, conn);
+            if ((events[i].events & EPOLLIN) && !readFromConnection(w, conn)) continue;
+            if (events[i].events & EPOLLOUT) serviceConnection(w, conn);
+        }
+        expireIdleConnections(w);
+    }
+}
+
+void runEpollServer(SOCKET serverSocket, int workerCount) {
+    vector<EpollWorker*> workers;
+    for (int i = 0; i < workerCount; i++) {
+        EpollWorker* w = new EpollWorker;
+        w->epollFd = epoll_create1(0);
+        w->wakeFd = eventfd(0, EFD_NONBLOCK);
+        w->lruHead = w->lruTail = nullptr;
+        if (w->epollFd < 0 || w->wakeFd < 0) {
+            cerr << "epoll setup failed: " << errno << "\n";
+            return;
+        }
+        epoll_event ev;
+        ev.events = EPOLLIN;
+        ev.data.ptr = nullptr;  // marks the wake-up eventfd
+        epoll_ctl(w->epollFd, EPOLL_CTL_ADD, w->wakeFd, &ev);
+        workers.push_back(w);
+        thread(runEpollWorker, w).detach();
+    }
+    
+    // Held in reserve for running out of descriptors: accept then fails
+    // without waiting and a pending client stays in the backlog, so the loop
+    // would spin. Wait for a client instead, give the spare up to accept and
+    // drop it, then take the spare back.
+    int spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+    
+    int nextWorker = 0;
+    while (true) {
+        SOCKET clientSocket = accept(serverSocket, nullptr, nullptr);
+        if (clientSocket == INVALID_SOCKET) {
+            if (errno != EMFILE && errno != ENFILE) continue;
+            if (spareFd < 0) {
+                this_thread::sleep_for(chrono::milliseconds(10));
+                spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+                continue;
+            }
+            pollfd listener = { serverSocket, POLLIN, 0 };
+            if (poll(&listener, 1, 100) <= 0) continue;  // retry once connections close
+            close(spareFd);
+            SOCKET dropped = accept(serverSocket, nullptr, nullptr);
+            if (dropped != INVALID_SOCKET) closesocket(dropped);
+            spareFd = open("/dev/null", O_RDONLY | O_CLOEXEC);
+            continue;
         }
         
-        // Get response
-        string jsonBody = handleRequest(path, method, body);
-        
-        // Build HTTP response
-        string response = "HTTP/1.1 200 OK\r\n"
-                         "Content-Type: application/json\r\n"
-                         "Access-Control-Allow-Origin: *\r\n"
-                         "Access-Control-Allow-Methods: GET, POST, PUT, DELETE, OPTIONS\r\n"
-                         "Access-Control-Allow-Headers: Content-Type\r\n"
-                         "Connection: close\r\n"
-                         "Content-Length: " + to_string(jsonBody.length()) + "\r\n"
-                         "\r\n" + jsonBody;
+        if (openConnections >= MAX_CONNECTIONS || !setNonBlocking(clientSocket)) {
+            closesocket(clientSocket);
+            continue;
+        }
+        openConnections++;
         
-        send(clientSocket, response.c_str(), response.length(), 0);
+        EpollWorker* w = workers[nextWorker];
+        {
+            lock_guard<mutex> lock(w->pendingLock);
+            w->pendingSockets.push_back(clientSocket);
+        }
+        uint64_t one = 1;
+        if (write(w->wakeFd, &one, sizeof(one)) < 0) {}
+        nextWorker = (nextWorker + 1) % workerCount;
     }
-    
-    closesocket(clientSocket);
 }
+#endif
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Server mode: --mode=threads (default) or --mode=epoll [--workers=N] [--keep-alive=off]
+    string mode = "threads";
+    int workerCount = (int)thread::hardware_concurrency();
+    if (workerCount <= 0) workerCount = 4;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg.rfind("--mode=", 0) == 0) mode = arg.substr(7);
+        else if (arg.rfind("--workers=", 0) == 0) workerCount = atoi(arg.c_str() + 10);
+        else if (arg == "--keep-alive=off") keepAliveEnabled = false;
+    }
+    if (workerCount < 1) workerCount = 1;
+#ifndef __linux__
+    if (mode == "epoll") {
+        cerr << "epoll mode is only available on Linux, falling back to threads\n";
+        mode = "threads";
+    }
+#endif
+    
+    registerRoutes();
+    
+#ifdef _WIN32
     WSADATA wsaData;
     if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0) {
         cerr << "WSAStartup failed\n";
         return 1;
     }
+#endif
     
     SOCKET serverSocket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
     if (serverSocket == INVALID_SOCKET) {
@@ -353,19 +2052,18 @@ int main() {
     cout << "  http://localhost:" << PORT << "\n";
     cout << "  Status: RUNNING\n";
     cout << "  Data Structures: Hash Table + BST\n";
+    if (mode == "epoll")
+        cout << "  Mode: epoll (" << workerCount << " workers)\n";
+    else
+        cout << "  Mode: thread per connection\n";
     cout << "========================================\n\n";
     
-    SOCKET clientSocket;
-    SOCKADDR_IN clientAddr;
-    int clientAddrLen = sizeof(clientAddr);
-    
-    while (true) {
-        clientSocket = accept(serverSocket, (SOCKADDR*)&clientAddr, &clientAddrLen);
-        if (clientSocket != INVALID_SOCKET) {
-            thread t(handleClient, clientSocket);
-            t.detach();
-        }
-    }
+#ifdef __linux__
+    if (mode == "epoll")
+        runEpollServer(serverSocket, workerCount);
+    else
+#endif
+        runThreadPerConnection(serverSocket);
     
     closesocket(serverSocket);
     WSACleanup();
@@ -4,6 +4,29 @@
 #include <string>
 #include <filesystem>
 #include <iomanip>
+#include <cstdio>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <future>
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <io.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 #include "json_handler.h"
 
 using namespace std;
@@ -41,688 +64,1869 @@ string escapeJSON(const string& str) {
     return result;
 }
 
-// Helper: Unescape JSON strings
-string unescapeJSON(const string& str) {
-    string result;
-    for (size_t i = 0; i < str.length(); i++) {
-        if (str[i] == '\\' && i + 1 < str.length()) {
-            switch (str[i + 1]) {
-                case '"': result += '"'; i++; break;
-                case '\\': result += '\\'; i++; break;
-                case 'b': result += '\b'; i++; break;
-                case 'f': result += '\f'; i++; break;
-                case 'n': result += '\n'; i++; break;
-                case 'r': result += '\r'; i++; break;
-                case 't': result += '\t'; i++; break;
-                default: result += str[i];
-            }
-        } else {
-            result += str[i];
-        }
+// Helper: Writes one JSON object either pretty (snapshot files, one field per
+// line) or compact (a single line, used for write-ahead log records)
+struct JsonObjectWriter {
+    ostream& out;
+    bool pretty;
+    bool first;
+
+    JsonObjectWriter(ostream& o, bool prettyPrint) : out(o), pretty(prettyPrint), first(true) {
+        out << (pretty ? "  {\n" : "{");
     }
-    return result;
+
+    void key(const string& name) {
+        if (!first) out << (pretty ? ",\n" : ",");
+        first = false;
+        out << (pretty ? "    \"" : "\"") << name << (pretty ? "\": " : "\":");
+    }
+
+    void intField(const string& name, int value) { key(name); out << value; }
+    void boolField(const string& name, bool value) { key(name); out << (value ? "true" : "false"); }
+    void stringField(const string& name, const string& value) { key(name); out << "\"" << escapeJSON(value) << "\""; }
+    void rawField(const string& name, const string& value) { key(name); out << value; }
+
+    void end() {
+        out << (pretty ? "\n  }" : "}");
+    }
+};
+
+// Helper: Parse a "dd-mm-yyyy" date written by formatDate
+SimpleDate parseJSONDate(const string& value) {
+    return { stoi(value.substr(0, 2)), stoi(value.substr(3, 2)), stoi(value.substr(6, 4)) };
 }
 
-// Helper: Extract value from JSON string
-string extractJSONValue(const string& json, const string& key, bool isString = true) {
-    string searchKey = "\"" + key + "\":";
-    size_t keyPos = json.find(searchKey);
-    if (keyPos == string::npos) return "";
-    
-    size_t startPos = keyPos + searchKey.length();
-    while (startPos < json.length() && (json[startPos] == ' ' || json[startPos] == '\n' || json[startPos] == '\t'))
-        startPos++;
-    
-    if (isString) {
-        if (json[startPos] != '"') return "";
-        startPos++;
-        size_t endPos = startPos;
-        while (endPos < json.length() && json[endPos] != '"') {
-            if (json[endPos] == '\\') endPos++;
-            endPos++;
+// Helper: Single-pass reader for the data/*.json layout, an array of flat
+// objects. The file is pulled through a fixed 64 KB buffer, so memory does
+// not grow with file size, and the key/value strings are reused from field
+// to field instead of copying each object out first:
+//     while (reader.nextObject())
+//         while (reader.nextField()) setXField(item, reader.key, reader.value);
+// String values arrive unescaped; numbers and booleans arrive as their raw
+// text; a nested array or object arrives as its raw JSON text.
+struct JsonStreamReader {
+    istream* in;            // nullptr when reading an in-memory string
+    vector<char> buffer;
+    const char* pos;
+    const char* end;
+    bool inObject;
+    string key;
+    string value;
+
+    JsonStreamReader(istream& input) : in(&input), buffer(64 * 1024), pos(nullptr), end(nullptr), inObject(false) {}
+    JsonStreamReader(const string& text) : in(nullptr), pos(text.data()), end(text.data() + text.length()), inObject(false) {}
+
+    bool fill() {
+        if (in == nullptr) return false;
+        in->read(buffer.data(), (streamsize)buffer.size());
+        pos = buffer.data();
+        end = pos + in->gcount();
+        return pos < end;
+    }
+
+    int peek() {
+        if (pos == end && !fill()) return -1;
+        return (unsigned char)*pos;
+    }
+
+    int get() {
+        int c = peek();
+        if (c >= 0) pos++;
+        return c;
+    }
+
+    // Separators carry no information in this layout, so commas are skipped with whitespace
+    void skipSpace() {
+        int c;
+        while ((c = peek()) == ' ' || c == '\n' || c == '\r' || c == '\t' || c == ',') pos++;
+    }
+
+    void expect(char wanted) {
+        if (get() != wanted) throw runtime_error(string("expected '") + wanted + "'");
+    }
+
+    void readString(string& out) {
+        out.clear();
+        while (true) {
+            if (pos == end && !fill()) throw runtime_error("unterminated string");
+            const char* run = pos;
+            while (run < end && *run != '"' && *run != '\\') run++;
+            out.append(pos, run - pos);
+            pos = run;
+            if (pos == end) continue;
+            if (*pos++ == '"') return;
+            int c = get();
+            switch (c) {
+                case '"': out += '"'; break;
+                case '\\': out += '\\'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'n': out += '\n'; break;
+                case 'r': out += '\r'; break;
+                case 't': out += '\t'; break;
+                case -1: throw runtime_error("unterminated string");
+                default: out += '\\'; out += (char)c;
+            }
         }
-        return unescapeJSON(json.substr(startPos, endPos - startPos));
-    } else {
-        size_t endPos = startPos;
-        while (endPos < json.length() && json[endPos] != ',' && json[endPos] != '}' && json[endPos] != ']')
-            endPos++;
-        return json.substr(startPos, endPos - startPos);
     }
-}
 
-/* ==================== USERS ==================== */
+    // Copy a nested array/object through verbatim
+    void readNested(string& out) {
+        out.clear();
+        int depth = 0;
+        bool inString = false;
+        do {
+            int c = get();
+            if (c < 0) throw runtime_error("unterminated value");
+            out += (char)c;
+            if (inString) {
+                if (c == '\\') out += (char)get();
+                else if (c == '"') inString = false;
+            } else if (c == '"') {
+                inString = true;
+            } else if (c == '[' || c == '{') {
+                depth++;
+            } else if (c == ']' || c == '}') {
+                depth--;
+            }
+        } while (depth > 0);
+    }
 
-void saveUsersToJSON() {
-    try {
-        ofstream file("data/users.json");
-        if (!file.is_open()) {
-            cerr << "[JSON ERROR] Cannot open data/users.json for writing.\n";
-            return;
+    // Advance to the next object of the top-level array (or to a lone
+    // object); false at the end of the array
+    bool nextObject() {
+        while (inObject) nextField();
+        while (true) {
+            skipSpace();
+            int c = peek();
+            if (c == '[') { pos++; continue; }
+            if (c == ']' || c < 0) return false;
+            expect('{');
+            inObject = true;
+            return true;
         }
+    }
 
-        file << "[\n";
-        User* curr = userListHead;
-        bool first = true;
-        int count = 0;
-
-        while (curr != nullptr) {
-            if (!first) file << ",\n";
-            first = false;
-
-            file << "  {\n";
-            file << "    \"userId\": " << curr->userId << ",\n";
-            file << "    \"username\": \"" << escapeJSON(curr->username) << "\",\n";
-            file << "    \"password\": \"" << escapeJSON(curr->password) << "\",\n";
-            file << "    \"role\": \"" << escapeJSON(curr->role) << "\",\n";
-            file << "    \"active\": " << (curr->active ? "true" : "false") << "\n";
-            file << "  }";
-
-            curr = curr->nextInList;
-            count++;
+    // Read the next field of the current object into key/value; false at '}'
+    bool nextField() {
+        if (!inObject) return false;
+        skipSpace();
+        if (peek() == '}') {
+            pos++;
+            inObject = false;
+            return false;
         }
+        expect('"');
+        readString(key);
+        skipSpace();
+        expect(':');
+        skipSpace();
+        int c = peek();
+        if (c == '"') {
+            pos++;
+            readString(value);
+        } else if (c == '[' || c == '{') {
+            readNested(value);
+        } else {
+            value.clear();
+            while ((c = peek()) >= 0 && c != ',' && c != '}' && c != ']' && c != ' ' && c != '\n' && c != '\r' && c != '\t') {
+                value += (char)c;
+                pos++;
+            }
+        }
+        return true;
+    }
+};
 
-        file << "\n]\n";
-        file.close();
-        cout << "[JSON] Saved " << count << " users to data/users.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to save users: " << e.what() << "\n";
+// Helper: Build one entity from the rest of the reader's current object
+template <typename T>
+T* readObject(JsonStreamReader& reader, void (*setField)(T*, const string&, const string&)) {
+    T* item = newNode<T>();
+    try {
+        while (reader.nextField()) setField(item, reader.key, reader.value);
+    } catch (...) {
+        deleteNode(item);
+        throw;
     }
+    return item;
 }
 
-void loadUsersFromJSON() {
+// Nodes read from one file but not yet linked into the shared structures.
+// Parsing touches nothing shared except the type's own node pool (crops
+// also fill cropStore) and the locked intern table, so collections can be
+// parsed on separate threads; on error, the objects read before it are
+// kept (as loading one at a time always did).
+template <typename T>
+struct ParsedFile {
+    vector<T*> items;
+    bool found = false;
+    string error;
+};
+
+// Helper: Read every object of a data/*.json file
+template <typename T>
+ParsedFile<T> parseJSONArray(const string& path, void (*setField)(T*, const string&, const string&)) {
+    ParsedFile<T> parsed;
+    ifstream file(path, ios::binary);
+    if (!file.is_open()) return parsed;
+    parsed.found = true;
     try {
-        ifstream file("data/users.json");
-        if (!file.is_open()) {
-            cout << "[JSON] No existing users.json found. Starting fresh.\n";
-            return;
-        }
+        JsonStreamReader reader(file);
+        while (reader.nextObject()) parsed.items.push_back(readObject(reader, setField));
+    } catch (const exception& e) {
+        parsed.error = e.what();
+    }
+    return parsed;
+}
 
-        stringstream buffer;
-        buffer << file.rdbuf();
-        string json = buffer.str();
-        file.close();
-
-        size_t pos = 0;
-        int count = 0;
-        while ((pos = json.find("\"userId\"", pos)) != string::npos) {
-            size_t objStart = json.rfind('{', pos);
-            size_t objEnd = json.find('}', pos);
-            if (objStart == string::npos || objEnd == string::npos) break;
-
-            string obj = json.substr(objStart, objEnd - objStart + 1);
-
-            User* newUser = new User;
-            newUser->userId = stoi(extractJSONValue(obj, "userId", false));
-            newUser->username = extractJSONValue(obj, "username", true);
-            newUser->password = extractJSONValue(obj, "password", true);
-            newUser->role = extractJSONValue(obj, "role", true);
-            newUser->active = extractJSONValue(obj, "active", false) == "true";
-            newUser->nextInBucket = nullptr;
-            newUser->nextInList = nullptr;
-
-            insertUser(newUser);
-            count++;
-            pos = objEnd + 1;
-        }
+// Helper: Flush <path>.tmp to disk and rename it over <path>, so a crash
+// mid-save leaves either the old file or the new one, never a torn one
+bool commitSnapshotFile(const string& path) {
+    string tmpPath = path + ".tmp";
+    FILE* tmp = fopen(tmpPath.c_str(), "r+b");
+    if (tmp == nullptr) return false;
+#ifdef _WIN32
+    _commit(_fileno(tmp));
+#else
+    fsync(fileno(tmp));
+#endif
+    fclose(tmp);
+    error_code ec;
+    fs::rename(tmpPath, path, ec);
+    return !ec;
+}
 
-        cout << "[JSON] Loaded " << count << " users from data/users.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to load users: " << e.what() << "\n";
+/* ==================== DIRTY TRACKING ====================
+ * Every collection carries a version bumped by its mutators (markDirty).
+ * saveAllData() only rewrites collections whose version moved since they
+ * were last written, plus any whose file is missing.
+ */
+
+const char* COLLECTION_FILES[DATA_COLLECTION_COUNT] = {
+    "data/users.json", "data/crops.json", "data/orders.json", "data/transport_requests.json",
+    "data/storage_requests.json", "data/vehicles.json", "data/storage_centers.json"
+};
+
+const char* COLLECTION_NAMES[DATA_COLLECTION_COUNT] = {
+    "users", "crops", "orders", "transport requests", "storage requests", "vehicles", "storage centers"
+};
+
+unsigned long long collectionVersion[DATA_COLLECTION_COUNT] = { 0 };
+unsigned long long savedVersion[DATA_COLLECTION_COUNT] = { 0 };
+
+void markDirty(DataCollection collection) {
+    collectionVersion[collection]++;
+}
+
+// Everything in memory now matches the files on disk
+void markAllClean() {
+    for (int i = 0; i < DATA_COLLECTION_COUNT; i++) savedVersion[i] = collectionVersion[i];
+}
+
+// Force the next saveAllData() to rewrite every collection
+void markAllDirty() {
+    for (int i = 0; i < DATA_COLLECTION_COUNT; i++) savedVersion[i] = collectionVersion[i] - 1;
+}
+
+bool needsSave(DataCollection collection) {
+    error_code ec;
+    return collectionVersion[collection] != savedVersion[collection] ||
+           !fs::exists(COLLECTION_FILES[collection], ec);
+}
+
+/* ==================== USERS ==================== */
+
+void writeUserFields(JsonObjectWriter& w, User* user) {
+    w.intField("userId", user->userId);
+    w.stringField("username", user->username);
+    w.stringField("password", user->password);
+    w.stringField("role", symbolName(user->role));
+    w.boolField("active", user->active);
+}
+
+// Apply one field of a stored object; unknown keys are skipped
+void setUserField(User* user, const string& key, const string& value) {
+    if (key == "userId") user->userId = stoi(value);
+    else if (key == "username") user->username = value;
+    else if (key == "password") user->password = value;
+    else if (key == "role") user->role = (Role)intern(value);
+    else if (key == "active") user->active = value == "true";
+}
+
+// Serialize the whole collection as the contents of data/users.json; returns the record count
+int writeUsersJSON(ostream& file) {
+    file << "[\n";
+    User* curr = userListHead;
+    bool first = true;
+    int count = 0;
+
+    while (curr != nullptr) {
+        if (!first) file << ",\n";
+        first = false;
+
+        JsonObjectWriter w(file, true);
+        writeUserFields(w, curr);
+        w.end();
+
+        curr = curr->nextInList;
+        count++;
     }
+
+    file << "\n]\n";
+    return count;
 }
 
 /* ==================== CROPS ==================== */
 
-void saveCropsToJSON() {
-    try {
-        ofstream file("data/crops.json");
-        if (!file.is_open()) {
-            cerr << "[JSON ERROR] Cannot open data/crops.json for writing.\n";
-            return;
-        }
+void writeCropFields(JsonObjectWriter& w, Crop* crop) {
+    w.intField("cropId", crop->cropId);
+    w.intField("farmerId", cropFarmerId(crop));
+    w.stringField("cropType", symbolName(cropType(crop)));
+    w.intField("quantity", cropQuantity(crop));
+    w.intField("storageQuantity", crop->storageQuantity);
+    w.stringField("quality", symbolName(crop->quality));
+    w.intField("pricePerKg", cropPrice(crop));
+    w.boolField("available", cropAvailable(crop));
+    w.stringField("dateAdded", formatDate(crop->dateAdded));
+    w.stringField("expiryDate", formatDate(crop->expiryDate));
+    w.stringField("storageCenter", crop->storageCenter);
+}
 
-        file << "[\n";
-        
-        // In-order traversal of BST
-        function<void(Crop*, bool&)> traverse = [&](Crop* node, bool& first) {
-            if (node == nullptr) return;
-            traverse(node->left, first);
-
-            if (!first) file << ",\n";
-            first = false;
-
-            file << "  {\n";
-            file << "    \"cropId\": " << node->cropId << ",\n";
-            file << "    \"farmerId\": " << node->farmerId << ",\n";
-            file << "    \"cropType\": \"" << escapeJSON(node->cropType) << "\",\n";
-            file << "    \"quantity\": " << node->quantity << ",\n";
-            file << "    \"storageQuantity\": " << node->storageQuantity << ",\n";
-            file << "    \"quality\": \"" << escapeJSON(node->quality) << "\",\n";
-            file << "    \"pricePerKg\": " << node->pricePerKg << ",\n";
-            file << "    \"available\": " << (node->available ? "true" : "false") << ",\n";
-            file << "    \"dateAdded\": \"" << formatDate(node->dateAdded) << "\",\n";
-            file << "    \"expiryDate\": \"" << formatDate(node->expiryDate) << "\",\n";
-            file << "    \"storageCenter\": \"" << escapeJSON(node->storageCenter) << "\"\n";
-            file << "  }";
-
-            traverse(node->right, first);
-        };
-
-        bool first = true;
-        traverse(cropBSTRoot, first);
-
-        file << "\n]\n";
-        file.close();
-        cout << "[JSON] Saved " << cropCount << " crops to data/crops.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to save crops: " << e.what() << "\n";
+// Apply one field of a stored object; unknown keys are skipped
+void setCropField(Crop* crop, const string& key, const string& value) {
+    if (key == "cropId") crop->cropId = stoi(value);
+    else if (key == "farmerId") cropFarmerId(crop) = stoi(value);
+    else if (key == "cropType") cropType(crop) = intern(value);
+    else if (key == "quantity") cropQuantity(crop) = stoi(value);
+    else if (key == "storageQuantity") crop->storageQuantity = stoi(value);
+    else if (key == "quality") crop->quality = (Quality)intern(value);
+    else if (key == "pricePerKg") cropPrice(crop) = stoi(value);
+    else if (key == "available") cropAvailable(crop) = value == "true";
+    else if (key == "storageCenter") crop->storageCenter = value;
+    else if (key == "dateAdded") crop->dateAdded = parseJSONDate(value);
+    else if (key == "expiryDate") crop->expiryDate = parseJSONDate(value);
+}
+
+// Serialize the whole collection as the contents of data/crops.json; returns the record count
+int writeCropsJSON(ostream& file) {
+    file << "[\n";
+
+    // In-order traversal of BST
+    function<void(Crop*, bool&)> traverse = [&](Crop* node, bool& first) {
+        if (node == nullptr) return;
+        traverse(node->left, first);
+
+        if (!first) file << ",\n";
+        first = false;
+
+        JsonObjectWriter w(file, true);
+        writeCropFields(w, node);
+        w.end();
+
+        traverse(node->right, first);
+    };
+
+    bool first = true;
+    traverse(cropBSTRoot, first);
+
+    file << "\n]\n";
+    return cropCount;
+}
+
+/* ==================== ORDERS ==================== */
+
+void writeOrderFields(JsonObjectWriter& w, Order* order) {
+    w.intField("orderId", order->orderId);
+    w.intField("cropId", order->cropId);
+    w.intField("buyerId", order->buyerId);
+    w.intField("farmerId", order->farmerId);
+    w.intField("quantity", order->quantity);
+    w.boolField("farmerApproved", order->farmerApproved);
+    w.boolField("paid", order->paid);
+    w.boolField("delivered", order->delivered);
+    w.stringField("orderDate", formatDate(order->orderDate));
+}
+
+// Apply one field of a stored object; unknown keys are skipped
+void setOrderField(Order* order, const string& key, const string& value) {
+    if (key == "orderId") order->orderId = stoi(value);
+    else if (key == "cropId") order->cropId = stoi(value);
+    else if (key == "buyerId") order->buyerId = stoi(value);
+    else if (key == "farmerId") order->farmerId = stoi(value);
+    else if (key == "quantity") order->quantity = stoi(value);
+    else if (key == "farmerApproved") order->farmerApproved = value == "true";
+    else if (key == "paid") order->paid = value == "true";
+    else if (key == "delivered") order->delivered = value == "true";
+    else if (key == "orderDate" && !value.empty()) order->orderDate = parseJSONDate(value);
+}
+
+// Serialize the whole collection as the contents of data/orders.json; returns the record count
+int writeOrdersJSON(ostream& file) {
+    file << "[\n";
+    Order* curr = orderHead;
+    bool first = true;
+    int count = 0;
+
+    while (curr != nullptr) {
+        if (!first) file << ",\n";
+        first = false;
+
+        JsonObjectWriter w(file, true);
+        writeOrderFields(w, curr);
+        w.end();
+
+        curr = curr->next;
+        count++;
     }
+
+    file << "\n]\n";
+    return count;
 }
 
-void loadCropsFromJSON() {
-    try {
-        ifstream file("data/crops.json");
-        if (!file.is_open()) {
-            cout << "[JSON] No existing crops.json found. Starting fresh.\n";
-            return;
+/* ==================== TRANSPORT REQUESTS ==================== */
+
+void writeTransportRequestFields(JsonObjectWriter& w, TransportRequest* req) {
+    w.intField("requestId", req->requestId);
+    w.intField("weight", req->weight);
+    w.intField("distance", req->distance);
+    w.intField("budget", req->budget);
+    w.stringField("organization", symbolName(req->organization));
+    w.boolField("accepted", req->accepted);
+    w.boolField("rejected", req->rejected);
+    w.boolField("completed", req->completed);
+    w.intField("requesterId", req->requesterId);
+    // Crop lines as parallel arrays; files written before they were saved
+    // simply have none, and ones written before orderIds have no orders
+    stringstream cropIdList, quantityList, orderIdList;
+    TransportLine* lines = transportLines(req);
+    for (int i = 0; i < req->cropCount; i++) {
+        if (i > 0) {
+            cropIdList << ", ";
+            quantityList << ", ";
+            orderIdList << ", ";
         }
+        cropIdList << lines[i].cropId;
+        quantityList << lines[i].quantity;
+        orderIdList << lines[i].orderId;
+    }
+    w.rawField("cropIds", "[" + cropIdList.str() + "]");
+    w.rawField("quantities", "[" + quantityList.str() + "]");
+    w.rawField("orderIds", "[" + orderIdList.str() + "]");
+}
 
-        stringstream buffer;
-        buffer << file.rdbuf();
-        string json = buffer.str();
-        file.close();
-
-        size_t pos = 0;
-        int count = 0;
-        while ((pos = json.find("\"cropId\"", pos)) != string::npos) {
-            size_t objStart = json.rfind('{', pos);
-            size_t objEnd = json.find('}', pos);
-            if (objStart == string::npos || objEnd == string::npos) break;
-
-            string obj = json.substr(objStart, objEnd - objStart + 1);
-
-            Crop* newCrop = new Crop;
-            newCrop->cropId = stoi(extractJSONValue(obj, "cropId", false));
-            newCrop->farmerId = stoi(extractJSONValue(obj, "farmerId", false));
-            newCrop->cropType = extractJSONValue(obj, "cropType", true);
-            newCrop->quantity = stoi(extractJSONValue(obj, "quantity", false));
-            newCrop->storageQuantity = stoi(extractJSONValue(obj, "storageQuantity", false));
-            newCrop->quality = extractJSONValue(obj, "quality", true);
-            newCrop->pricePerKg = stoi(extractJSONValue(obj, "pricePerKg", false));
-            newCrop->available = extractJSONValue(obj, "available", false) == "true";
-            newCrop->storageCenter = extractJSONValue(obj, "storageCenter", true);
-            newCrop->left = newCrop->right = nullptr;
-
-            // Parse dates
-            string dateAddedStr = extractJSONValue(obj, "dateAdded", true);
-            newCrop->dateAdded = {stoi(dateAddedStr.substr(0, 2)), stoi(dateAddedStr.substr(3, 2)), stoi(dateAddedStr.substr(6, 4))};
-            
-            string expiryDateStr = extractJSONValue(obj, "expiryDate", true);
-            newCrop->expiryDate = {stoi(expiryDateStr.substr(0, 2)), stoi(expiryDateStr.substr(3, 2)), stoi(expiryDateStr.substr(6, 4))};
-
-            cropBSTRoot = insertCropBST(cropBSTRoot, newCrop);
-            cropCount++;
-            count++;
-            pos = objEnd + 1;
+// Fill one column of the crop lines from a raw JSON int array; whichever
+// column comes first creates the lines
+void setTransportLineColumn(TransportRequest* req, int TransportLine::* column, const string& array) {
+    const char* pos = array.c_str();
+    int index = 0;
+    while (*pos != '\0') {
+        if ((*pos < '0' || *pos > '9') && *pos != '-') {
+            pos++;
+            continue;
+        }
+        char* end;
+        int value = (int)strtol(pos, &end, 10);
+        if (end == pos) {  // a lone '-'
+            pos++;
+            continue;
         }
+        pos = end;
+        if (index == req->cropCount) addTransportLine(req, 0, 0, 0);
+        transportLines(req)[index].*column = value;
+        index++;
+    }
+}
 
-        cout << "[JSON] Loaded " << count << " crops from data/crops.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to load crops: " << e.what() << "\n";
+// Apply one field of a stored object; unknown keys are skipped
+void setTransportRequestField(TransportRequest* req, const string& key, const string& value) {
+    if (key == "requestId") req->requestId = stoi(value);
+    else if (key == "weight") req->weight = stoi(value);
+    else if (key == "distance") req->distance = stoi(value);
+    else if (key == "budget") req->budget = stoi(value);
+    else if (key == "organization") req->organization = intern(value);
+    else if (key == "accepted") req->accepted = value == "true";
+    else if (key == "rejected") req->rejected = value == "true";
+    else if (key == "completed") req->completed = value == "true";
+    else if (key == "requesterId") req->requesterId = stoi(value);
+    else if (key == "cropIds") setTransportLineColumn(req, &TransportLine::cropId, value);
+    else if (key == "quantities") setTransportLineColumn(req, &TransportLine::quantity, value);
+    else if (key == "orderIds") setTransportLineColumn(req, &TransportLine::orderId, value);
+}
+
+// Serialize the whole collection as the contents of data/transport_requests.json; returns the record count
+int writeTransportRequestsJSON(ostream& file) {
+    file << "[\n";
+    TransportRequest* curr = transportHead;
+    bool first = true;
+    int count = 0;
+
+    while (curr != nullptr) {
+        if (!first) file << ",\n";
+        first = false;
+
+        JsonObjectWriter w(file, true);
+        writeTransportRequestFields(w, curr);
+        w.end();
+
+        curr = curr->next;
+        count++;
     }
+
+    file << "\n]\n";
+    return count;
 }
 
-/* ==================== ORDERS ==================== */
+/* ==================== STORAGE REQUESTS ==================== */
 
-void saveOrdersToJSON() {
-    try {
-        ofstream file("data/orders.json");
-        if (!file.is_open()) {
-            cerr << "[JSON ERROR] Cannot open data/orders.json for writing.\n";
-            return;
-        }
+void writeStorageRequestFields(JsonObjectWriter& w, StorageRequest* req) {
+    w.intField("requestId", req->requestId);
+    w.intField("cropId", req->cropId);
+    w.intField("quantity", req->quantity);
+    w.intField("budget", req->budget);
+    w.intField("pricePerKg", req->pricePerKg);
+    w.stringField("cropName", req->cropName);
+    w.stringField("organization", symbolName(req->organization));
+    w.boolField("accepted", req->accepted);
+    w.boolField("rejected", req->rejected);
+    w.intField("requesterId", req->requesterId);
+}
 
-        file << "[\n";
-        Order* curr = orderHead;
-        bool first = true;
-        int count = 0;
-
-        while (curr != nullptr) {
-            if (!first) file << ",\n";
-            first = false;
-
-            file << "  {\n";
-            file << "    \"orderId\": " << curr->orderId << ",\n";
-            file << "    \"cropId\": " << curr->cropId << ",\n";
-            file << "    \"buyerId\": " << curr->buyerId << ",\n";
-            file << "    \"farmerId\": " << curr->farmerId << ",\n";
-            file << "    \"quantity\": " << curr->quantity << ",\n";
-            file << "    \"farmerApproved\": " << (curr->farmerApproved ? "true" : "false") << ",\n";
-            file << "    \"paid\": " << (curr->paid ? "true" : "false") << ",\n";
-            file << "    \"delivered\": " << (curr->delivered ? "true" : "false") << ",\n";
-            file << "    \"orderDate\": \"" << formatDate(curr->orderDate) << "\"\n";
-            file << "  }";
-
-            curr = curr->next;
-            count++;
-        }
+// Apply one field of a stored object; unknown keys are skipped
+void setStorageRequestField(StorageRequest* req, const string& key, const string& value) {
+    if (key == "requestId") req->requestId = stoi(value);
+    else if (key == "cropId") req->cropId = stoi(value);
+    else if (key == "quantity") req->quantity = stoi(value);
+    else if (key == "budget") req->budget = stoi(value);
+    else if (key == "pricePerKg") req->pricePerKg = stoi(value);
+    else if (key == "cropName") req->cropName = value;
+    else if (key == "organization") req->organization = intern(value);
+    else if (key == "accepted") req->accepted = value == "true";
+    else if (key == "rejected") req->rejected = value == "true";
+    else if (key == "requesterId") req->requesterId = stoi(value);
+}
 
-        file << "\n]\n";
-        file.close();
-        cout << "[JSON] Saved " << count << " orders to data/orders.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to save orders: " << e.what() << "\n";
+// Serialize the whole collection as the contents of data/storage_requests.json; returns the record count
+int writeStorageRequestsJSON(ostream& file) {
+    file << "[\n";
+    StorageRequest* curr = storageHead;
+    bool first = true;
+    int count = 0;
+
+    while (curr != nullptr) {
+        if (!first) file << ",\n";
+        first = false;
+
+        JsonObjectWriter w(file, true);
+        writeStorageRequestFields(w, curr);
+        w.end();
+
+        curr = curr->next;
+        count++;
     }
+
+    file << "\n]\n";
+    return count;
 }
 
-void loadOrdersFromJSON() {
-    try {
-        ifstream file("data/orders.json");
-        if (!file.is_open()) {
-            cout << "[JSON] No existing orders.json found. Starting fresh.\n";
-            return;
-        }
+/* ==================== VEHICLES ==================== */
 
-        stringstream buffer;
-        buffer << file.rdbuf();
-        string json = buffer.str();
-        file.close();
-
-        size_t pos = 0;
-        int count = 0;
-        while ((pos = json.find("\"orderId\"", pos)) != string::npos) {
-            size_t objStart = json.rfind('{', pos);
-            size_t objEnd = json.find('}', pos);
-            if (objStart == string::npos || objEnd == string::npos) break;
-
-            string obj = json.substr(objStart, objEnd - objStart + 1);
-
-            Order* newOrder = new Order;
-            newOrder->orderId = stoi(extractJSONValue(obj, "orderId", false));
-            newOrder->cropId = stoi(extractJSONValue(obj, "cropId", false));
-            newOrder->buyerId = stoi(extractJSONValue(obj, "buyerId", false));
-            newOrder->farmerId = stoi(extractJSONValue(obj, "farmerId", false));
-            newOrder->quantity = stoi(extractJSONValue(obj, "quantity", false));
-            newOrder->farmerApproved = extractJSONValue(obj, "farmerApproved", false) == "true";
-            newOrder->paid = extractJSONValue(obj, "paid", false) == "true";
-            newOrder->delivered = extractJSONValue(obj, "delivered", false) == "true";
-            newOrder->next = nullptr;
-
-            addOrder(newOrder);
-            count++;
-            pos = objEnd + 1;
-        }
+void writeVehicleFields(JsonObjectWriter& w, Vehicle* vehicle) {
+    w.intField("vehicleId", vehicle->vehicleId);
+    w.intField("capacity", vehicle->capacity);
+    w.boolField("available", vehicle->available);
+    w.stringField("type", vehicle->type);
+    w.stringField("organization", symbolName(vehicle->organization));
+}
 
-        cout << "[JSON] Loaded " << count << " orders from data/orders.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to load orders: " << e.what() << "\n";
+// Apply one field of a stored object; unknown keys are skipped
+void setVehicleField(Vehicle* vehicle, const string& key, const string& value) {
+    if (key == "vehicleId") vehicle->vehicleId = stoi(value);
+    else if (key == "capacity") vehicle->capacity = stoi(value);
+    else if (key == "available") vehicle->available = value == "true";
+    else if (key == "type") vehicle->type = value;
+    else if (key == "organization") vehicle->organization = intern(value);
+}
+
+// Serialize the whole collection as the contents of data/vehicles.json; returns the record count
+int writeVehiclesJSON(ostream& file) {
+    file << "[\n";
+    Vehicle* curr = vehicleHead;
+    bool first = true;
+    int count = 0;
+
+    while (curr != nullptr) {
+        if (!first) file << ",\n";
+        first = false;
+
+        JsonObjectWriter w(file, true);
+        writeVehicleFields(w, curr);
+        w.end();
+
+        curr = curr->next;
+        count++;
     }
+
+    file << "\n]\n";
+    return count;
 }
 
-/* ==================== TRANSPORT REQUESTS ==================== */
+/* ==================== STORAGE CENTERS ==================== */
 
-void saveTransportRequestsToJSON() {
-    try {
-        ofstream file("data/transport_requests.json");
-        if (!file.is_open()) {
-            cerr << "[JSON ERROR] Cannot open data/transport_requests.json for writing.\n";
-            return;
-        }
+void writeStorageCenterFields(JsonObjectWriter& w, StorageCenter* center) {
+    stringstream temperature;
+    temperature << fixed << setprecision(1) << center->temperature;
+    w.stringField("organization", symbolName(center->organization));
+    w.intField("totalCapacity", center->totalCapacity);
+    w.intField("availableCapacity", center->availableCapacity);
+    w.rawField("temperature", temperature.str());
+    w.stringField("location", center->location);
+    w.intField("pricePerKg", center->pricePerKg);
+}
 
-        file << "[\n";
-        TransportRequest* curr = transportHead;
-        bool first = true;
-        int count = 0;
-
-        while (curr != nullptr) {
-            if (!first) file << ",\n";
-            first = false;
-
-            file << "  {\n";
-            file << "    \"requestId\": " << curr->requestId << ",\n";
-            file << "    \"weight\": " << curr->weight << ",\n";
-            file << "    \"distance\": " << curr->distance << ",\n";
-            file << "    \"budget\": " << curr->budget << ",\n";
-            file << "    \"organization\": \"" << escapeJSON(curr->organization) << "\",\n";
-            file << "    \"accepted\": " << (curr->accepted ? "true" : "false") << ",\n";
-            file << "    \"rejected\": " << (curr->rejected ? "true" : "false") << ",\n";
-            file << "    \"completed\": " << (curr->completed ? "true" : "false") << ",\n";
-            file << "    \"requesterId\": " << curr->requesterId << "\n";
-            file << "  }";
-
-            curr = curr->next;
-            count++;
-        }
+// Apply one field of a stored object; unknown keys are skipped
+void setStorageCenterField(StorageCenter* center, const string& key, const string& value) {
+    if (key == "organization") center->organization = intern(value);
+    else if (key == "totalCapacity") center->totalCapacity = stoi(value);
+    else if (key == "availableCapacity") center->availableCapacity = stoi(value);
+    else if (key == "temperature") center->temperature = stof(value);
+    else if (key == "location") center->location = value;
+    else if (key == "pricePerKg") center->pricePerKg = stoi(value);
+}
 
-        file << "\n]\n";
-        file.close();
-        cout << "[JSON] Saved " << count << " transport requests to data/transport_requests.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to save transport requests: " << e.what() << "\n";
+// Serialize the whole collection as the contents of data/storage_centers.json; returns the record count
+int writeStorageCentersJSON(ostream& file) {
+    file << "[\n";
+    StorageCenter* curr = storageCenterHead;
+    bool first = true;
+    int count = 0;
+
+    while (curr != nullptr) {
+        if (!first) file << ",\n";
+        first = false;
+
+        JsonObjectWriter w(file, true);
+        writeStorageCenterFields(w, curr);
+        w.end();
+
+        curr = curr->next;
+        count++;
     }
+
+    file << "\n]\n";
+    return count;
 }
 
-void loadTransportRequestsFromJSON() {
-    try {
-        ifstream file("data/transport_requests.json");
-        if (!file.is_open()) {
-            cout << "[JSON] No existing transport_requests.json found. Starting fresh.\n";
-            return;
+/* ==================== PARALLEL LOADING ====================
+ * Loading runs in three phases. Parse: every collection is read into a
+ * detached ParsedFile on its own thread, since the files are independent.
+ * Link: one thread inserts the nodes into the shared lists, trees and
+ * indexes in the fixed users-to-centers order (the structures are not
+ * thread-safe). Validate: cross-references are checked against the
+ * finished indexes, again in parallel since nothing is written. Startup
+ * then takes about as long as the largest collection, not all seven.
+ */
+
+struct LoadedData {
+    ParsedFile<User> users;
+    ParsedFile<Crop> crops;
+    ParsedFile<Order> orders;
+    ParsedFile<TransportRequest> transportRequests;
+    ParsedFile<StorageRequest> storageRequests;
+    ParsedFile<Vehicle> vehicles;
+    ParsedFile<StorageCenter> storageCenters;
+};
+
+template <typename T>
+void reportParsed(const ParsedFile<T>& parsed, DataCollection collection) {
+    if (!parsed.found) {
+        cout << "[JSON] No existing " << (COLLECTION_FILES[collection] + 5) << " found. Starting fresh.\n";
+    } else if (!parsed.error.empty()) {
+        cerr << "[JSON ERROR] Failed to load " << COLLECTION_NAMES[collection] << ": " << parsed.error << "\n";
+    } else {
+        cout << "[JSON] Loaded " << parsed.items.size() << " " << COLLECTION_NAMES[collection]
+             << " from " << COLLECTION_FILES[collection] << "\n";
+    }
+}
+
+void parseJSONFiles(LoadedData& data) {
+    auto users = async(launch::async, parseJSONArray<User>, COLLECTION_FILES[DATA_USERS], setUserField);
+    auto crops = async(launch::async, parseJSONArray<Crop>, COLLECTION_FILES[DATA_CROPS], setCropField);
+    auto orders = async(launch::async, parseJSONArray<Order>, COLLECTION_FILES[DATA_ORDERS], setOrderField);
+    auto transportRequests = async(launch::async, parseJSONArray<TransportRequest>, COLLECTION_FILES[DATA_TRANSPORT_REQUESTS], setTransportRequestField);
+    auto storageRequests = async(launch::async, parseJSONArray<StorageRequest>, COLLECTION_FILES[DATA_STORAGE_REQUESTS], setStorageRequestField);
+    auto vehicles = async(launch::async, parseJSONArray<Vehicle>, COLLECTION_FILES[DATA_VEHICLES], setVehicleField);
+    // The smallest file is parsed on this thread instead of idling
+    data.storageCenters = parseJSONArray<StorageCenter>(COLLECTION_FILES[DATA_STORAGE_CENTERS], setStorageCenterField);
+    data.users = users.get();
+    data.crops = crops.get();
+    data.orders = orders.get();
+    data.transportRequests = transportRequests.get();
+    data.storageRequests = storageRequests.get();
+    data.vehicles = vehicles.get();
+}
+
+// Single-threaded: builds the lists, the crop tree and the id/username indexes
+void linkLoadedData(LoadedData& data) {
+    reserveUsers((int)data.users.items.size());
+    reserveOrders((int)data.orders.items.size());
+    for (User* user : data.users.items) insertUser(user);
+    insertCrops(data.crops.items);
+    for (Order* order : data.orders.items) addOrder(order);
+    for (TransportRequest* req : data.transportRequests.items) addTransportRequest(req);
+    for (StorageRequest* req : data.storageRequests.items) addStorageRequest(req);
+    for (Vehicle* vehicle : data.vehicles.items) addVehicle(vehicle);
+    for (StorageCenter* center : data.storageCenters.items) addStorageCenter(center);
+}
+
+// Count references to users/crops that do not exist. They are reported, not
+// removed: nothing in the app deletes records, so a dangling id means the
+// files were edited or lost data, which the user should hear about.
+void validateReferences(const LoadedData& data) {
+    auto crops = async(launch::async, [&data] {
+        int missing = 0;
+        for (Crop* crop : data.crops.items) missing += findUserById(cropFarmerId(crop)) == nullptr;
+        return missing;
+    });
+    auto orders = async(launch::async, [&data] {
+        int missing = 0;
+        for (Order* order : data.orders.items) {
+            missing += findCropById(order->cropId) == nullptr || findUserById(order->buyerId) == nullptr ||
+                       findUserById(order->farmerId) == nullptr;
         }
+        return missing;
+    });
+    int transportMissing = 0;
+    for (TransportRequest* req : data.transportRequests.items) transportMissing += findUserById(req->requesterId) == nullptr;
+    int storageMissing = 0;
+    for (StorageRequest* req : data.storageRequests.items) {
+        storageMissing += findCropById(req->cropId) == nullptr || findUserById(req->requesterId) == nullptr;
+    }
 
-        stringstream buffer;
-        buffer << file.rdbuf();
-        string json = buffer.str();
-        file.close();
-
-        size_t pos = 0;
-        int count = 0;
-        while ((pos = json.find("\"requestId\"", pos)) != string::npos) {
-            size_t objStart = json.rfind('{', pos);
-            size_t objEnd = json.find('}', pos);
-            if (objStart == string::npos || objEnd == string::npos) break;
-
-            string obj = json.substr(objStart, objEnd - objStart + 1);
-
-            TransportRequest* newReq = new TransportRequest;
-            newReq->requestId = stoi(extractJSONValue(obj, "requestId", false));
-            newReq->weight = stoi(extractJSONValue(obj, "weight", false));
-            newReq->distance = stoi(extractJSONValue(obj, "distance", false));
-            newReq->budget = stoi(extractJSONValue(obj, "budget", false));
-            newReq->organization = extractJSONValue(obj, "organization", true);
-            newReq->accepted = extractJSONValue(obj, "accepted", false) == "true";
-            newReq->rejected = extractJSONValue(obj, "rejected", false) == "true";
-            newReq->completed = extractJSONValue(obj, "completed", false) == "true";
-            newReq->requesterId = stoi(extractJSONValue(obj, "requesterId", false));
-            newReq->next = nullptr;
-
-            addTransportRequest(newReq);
-            count++;
-            pos = objEnd + 1;
+    int missing[DATA_COLLECTION_COUNT] = { 0 };
+    missing[DATA_CROPS] = crops.get();
+    missing[DATA_ORDERS] = orders.get();
+    missing[DATA_TRANSPORT_REQUESTS] = transportMissing;
+    missing[DATA_STORAGE_REQUESTS] = storageMissing;
+    for (int i = 0; i < DATA_COLLECTION_COUNT; i++) {
+        if (missing[i] > 0) {
+            cerr << "[LOAD WARNING] " << missing[i] << " " << COLLECTION_NAMES[i]
+                 << " refer to a user or crop that does not exist.\n";
         }
+    }
+}
 
-        cout << "[JSON] Loaded " << count << " transport requests from data/transport_requests.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to load transport requests: " << e.what() << "\n";
+void loadJSONSnapshot() {
+    LoadedData data;
+    parseJSONFiles(data);
+    reportParsed(data.users, DATA_USERS);
+    reportParsed(data.crops, DATA_CROPS);
+    reportParsed(data.orders, DATA_ORDERS);
+    reportParsed(data.transportRequests, DATA_TRANSPORT_REQUESTS);
+    reportParsed(data.storageRequests, DATA_STORAGE_REQUESTS);
+    reportParsed(data.vehicles, DATA_VEHICLES);
+    reportParsed(data.storageCenters, DATA_STORAGE_CENTERS);
+    linkLoadedData(data);
+    validateReferences(data);
+}
+
+/* ==================== BINARY SNAPSHOT ====================
+ * Optional alternative to the seven JSON files: one data/snapshot.bin with
+ * a fixed header, a fixed-size record array per collection and a shared
+ * string table (records hold offset/length pairs into it). The file is
+ * memory-mapped and checksummed as a whole, so loading is one checksum pass
+ * plus one pass building nodes, with no text parsing. Records carry exactly
+ * the fields the JSON files do, so the two formats convert losslessly
+ * (--convert=json2bin / --convert=bin2json). Bump SNAPSHOT_VERSION whenever
+ * a record layout changes; versions that cannot be read are rejected and
+ * the JSON files are loaded instead. Version 2 appended a transport crop
+ * line section (and two header fields); version 3 added the order each
+ * line delivers. Version 1 files still load with no lines, version 2
+ * files with lines that name no order.
+ *
+ * Whichever format saved last is current: the binary file wins while it
+ * exists, and a JSON save deletes it once the JSON files are in place.
+ * Integers are stored in host byte order.
+ */
+
+const char* BINARY_SNAPSHOT_PATH = "data/snapshot.bin";
+const char SNAPSHOT_MAGIC[8] = { 'A', 'G', 'R', 'I', 'S', 'N', 'A', 'P' };
+const uint32_t SNAPSHOT_VERSION = 3;
+const uint32_t SNAPSHOT_V1_HEADER_SIZE = 136;
+
+SnapshotFormat snapshotFormat = SNAPSHOT_JSON;
+bool snapshotFormatChosen = false;  // otherwise keep the format that was loaded
+
+void setSnapshotFormat(SnapshotFormat format) {
+    snapshotFormat = format;
+    snapshotFormatChosen = true;
+}
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t headerSize;
+    uint32_t counts[DATA_COLLECTION_COUNT];
+    uint32_t reserved;
+    uint64_t offsets[DATA_COLLECTION_COUNT];  // start of each record array
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+    uint64_t fileSize;
+    uint64_t checksum;                        // of every byte after the header
+    uint64_t transportLinesOffset;            // version 2 onwards; same header in 3
+    uint32_t transportLineCount;
+    uint32_t reserved2;
+};
+
+struct BinString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct UserRecord {
+    int32_t userId;
+    BinString username, password, role;
+    uint8_t active, pad[3];
+};
+
+struct CropRecord {
+    int32_t cropId, farmerId, quantity, storageQuantity, pricePerKg;
+    int32_t dateAdded, expiryDate;  // yyyymmdd
+    BinString cropType, quality, storageCenter;
+    uint8_t available, pad[3];
+};
+
+struct OrderRecord {
+    int32_t orderId, cropId, buyerId, farmerId, quantity;
+    int32_t orderDate;  // yyyymmdd
+    uint8_t farmerApproved, paid, delivered, pad;
+};
+
+struct TransportRequestRecord {
+    int32_t requestId, weight, distance, budget, requesterId;
+    BinString organization;
+    uint8_t accepted, rejected, completed, pad;
+};
+
+// Lines are grouped by request, in the order of the transport record array
+struct TransportLineRecord {
+    uint32_t request;  // index into the transport record array
+    int32_t cropId;
+    int32_t quantity;
+    int32_t orderId;
+};
+
+// Version 2 line layout, read for compatibility
+struct TransportLineRecordV2 {
+    uint32_t request;
+    int32_t cropId;
+    int32_t quantity;
+};
+
+struct StorageRequestRecord {
+    int32_t requestId, cropId, quantity, budget, pricePerKg, requesterId;
+    BinString cropName, organization;
+    uint8_t accepted, rejected, pad[2];
+};
+
+struct VehicleRecord {
+    int32_t vehicleId, capacity;
+    BinString type, organization;
+    uint8_t available, pad[3];
+};
+
+struct StorageCenterRecord {
+    int32_t totalCapacity, availableCapacity, pricePerKg;
+    float temperature;
+    BinString organization, location;
+};
+
+static_assert(sizeof(SnapshotHeader) == 152, "snapshot header layout changed");
+static_assert(sizeof(UserRecord) == 32 && sizeof(CropRecord) == 56 && sizeof(OrderRecord) == 28 &&
+              sizeof(TransportRequestRecord) == 32 && sizeof(TransportLineRecord) == 16 && sizeof(StorageRequestRecord) == 44 &&
+              sizeof(VehicleRecord) == 28 && sizeof(StorageCenterRecord) == 32,
+              "snapshot record layout changed; bump SNAPSHOT_VERSION");
+
+int32_t packDate(const SimpleDate& date) {
+    return date.year * 10000 + date.month * 100 + date.day;
+}
+
+SimpleDate unpackDate(int32_t packed) {
+    return { packed % 100, packed / 100 % 100, packed / 10000 };
+}
+
+// FNV-1a over 64-bit words (bytewise for the tail): about one multiply per
+// 8 bytes, fast enough to verify the whole file on every start
+uint64_t snapshotChecksum(const char* data, size_t length) {
+    uint64_t hash = 14695981039346656037ULL;
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 1099511628211ULL;
     }
+    for (; i < length; i++) hash = (hash ^ (unsigned char)data[i]) * 1099511628211ULL;
+    return hash;
 }
 
-/* ==================== STORAGE REQUESTS ==================== */
+// Shared string table; repeated values (roles, crop types, organizations) are stored once
+struct BinaryStringTable {
+    string bytes;
+    unordered_map<string, BinString> seen;
+
+    BinString add(const string& value) {
+        auto found = seen.find(value);
+        if (found != seen.end()) return found->second;
+        BinString ref = { (uint32_t)bytes.length(), (uint32_t)value.length() };
+        bytes += value;
+        seen.emplace(value, ref);
+        return ref;
+    }
+};
 
-void saveStorageRequestsToJSON() {
-    try {
-        ofstream file("data/storage_requests.json");
-        if (!file.is_open()) {
-            cerr << "[JSON ERROR] Cannot open data/storage_requests.json for writing.\n";
-            return;
+template <typename Record>
+void appendRecord(string& section, const Record& record) {
+    section.append((const char*)&record, sizeof(Record));
+}
+
+// Serialize every collection into the snapshot.bin layout
+void writeBinarySnapshot(string& out) {
+    BinaryStringTable strings;
+    string sections[DATA_COLLECTION_COUNT];
+    string transportLineSection;
+    SnapshotHeader header = {};
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.headerSize = sizeof(SnapshotHeader);
+
+    for (User* u = userListHead; u != nullptr; u = u->nextInList) {
+        UserRecord r = {};
+        r.userId = u->userId;
+        r.username = strings.add(u->username);
+        r.password = strings.add(u->password);
+        r.role = strings.add(symbolName(u->role));
+        r.active = u->active;
+        appendRecord(sections[DATA_USERS], r);
+        header.counts[DATA_USERS]++;
+    }
+
+    // In price order, like crops.json, so loading can bulk-build the tree
+    vector<Crop*> stack;
+    Crop* node = cropBSTRoot;
+    while (node != nullptr || !stack.empty()) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->left;
         }
+        Crop* c = stack.back();
+        stack.pop_back();
+        CropRecord r = {};
+        r.cropId = c->cropId;
+        r.farmerId = cropFarmerId(c);
+        r.quantity = cropQuantity(c);
+        r.storageQuantity = c->storageQuantity;
+        r.pricePerKg = cropPrice(c);
+        r.dateAdded = packDate(c->dateAdded);
+        r.expiryDate = packDate(c->expiryDate);
+        r.cropType = strings.add(symbolName(cropType(c)));
+        r.quality = strings.add(symbolName(c->quality));
+        r.storageCenter = strings.add(c->storageCenter);
+        r.available = cropAvailable(c);
+        appendRecord(sections[DATA_CROPS], r);
+        header.counts[DATA_CROPS]++;
+        node = c->right;
+    }
+
+    for (Order* o = orderHead; o != nullptr; o = o->next) {
+        OrderRecord r = {};
+        r.orderId = o->orderId;
+        r.cropId = o->cropId;
+        r.buyerId = o->buyerId;
+        r.farmerId = o->farmerId;
+        r.quantity = o->quantity;
+        r.orderDate = packDate(o->orderDate);
+        r.farmerApproved = o->farmerApproved;
+        r.paid = o->paid;
+        r.delivered = o->delivered;
+        appendRecord(sections[DATA_ORDERS], r);
+        header.counts[DATA_ORDERS]++;
+    }
 
-        file << "[\n";
-        StorageRequest* curr = storageHead;
-        bool first = true;
-        int count = 0;
-
-        while (curr != nullptr) {
-            if (!first) file << ",\n";
-            first = false;
-
-            file << "  {\n";
-            file << "    \"requestId\": " << curr->requestId << ",\n";
-            file << "    \"cropId\": " << curr->cropId << ",\n";
-            file << "    \"quantity\": " << curr->quantity << ",\n";
-            file << "    \"budget\": " << curr->budget << ",\n";
-            file << "    \"pricePerKg\": " << curr->pricePerKg << ",\n";
-            file << "    \"cropName\": \"" << escapeJSON(curr->cropName) << "\",\n";
-            file << "    \"organization\": \"" << escapeJSON(curr->organization) << "\",\n";
-            file << "    \"accepted\": " << (curr->accepted ? "true" : "false") << ",\n";
-            file << "    \"rejected\": " << (curr->rejected ? "true" : "false") << ",\n";
-            file << "    \"requesterId\": " << curr->requesterId << "\n";
-            file << "  }";
-
-            curr = curr->next;
-            count++;
+    for (TransportRequest* t = transportHead; t != nullptr; t = t->next) {
+        TransportRequestRecord r = {};
+        r.requestId = t->requestId;
+        r.weight = t->weight;
+        r.distance = t->distance;
+        r.budget = t->budget;
+        r.requesterId = t->requesterId;
+        r.organization = strings.add(symbolName(t->organization));
+        r.accepted = t->accepted;
+        r.rejected = t->rejected;
+        r.completed = t->completed;
+        TransportLine* lines = transportLines(t);
+        for (int i = 0; i < t->cropCount; i++) {
+            TransportLineRecord line = { header.counts[DATA_TRANSPORT_REQUESTS], lines[i].cropId, lines[i].quantity, lines[i].orderId };
+            appendRecord(transportLineSection, line);
+            header.transportLineCount++;
         }
+        appendRecord(sections[DATA_TRANSPORT_REQUESTS], r);
+        header.counts[DATA_TRANSPORT_REQUESTS]++;
+    }
 
-        file << "\n]\n";
-        file.close();
-        cout << "[JSON] Saved " << count << " storage requests to data/storage_requests.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to save storage requests: " << e.what() << "\n";
+    for (StorageRequest* s = storageHead; s != nullptr; s = s->next) {
+        StorageRequestRecord r = {};
+        r.requestId = s->requestId;
+        r.cropId = s->cropId;
+        r.quantity = s->quantity;
+        r.budget = s->budget;
+        r.pricePerKg = s->pricePerKg;
+        r.requesterId = s->requesterId;
+        r.cropName = strings.add(s->cropName);
+        r.organization = strings.add(symbolName(s->organization));
+        r.accepted = s->accepted;
+        r.rejected = s->rejected;
+        appendRecord(sections[DATA_STORAGE_REQUESTS], r);
+        header.counts[DATA_STORAGE_REQUESTS]++;
+    }
+
+    for (Vehicle* v = vehicleHead; v != nullptr; v = v->next) {
+        VehicleRecord r = {};
+        r.vehicleId = v->vehicleId;
+        r.capacity = v->capacity;
+        r.type = strings.add(v->type);
+        r.organization = strings.add(symbolName(v->organization));
+        r.available = v->available;
+        appendRecord(sections[DATA_VEHICLES], r);
+        header.counts[DATA_VEHICLES]++;
+    }
+
+    for (StorageCenter* sc = storageCenterHead; sc != nullptr; sc = sc->next) {
+        StorageCenterRecord r = {};
+        r.totalCapacity = sc->totalCapacity;
+        r.availableCapacity = sc->availableCapacity;
+        r.pricePerKg = sc->pricePerKg;
+        r.temperature = sc->temperature;
+        r.organization = strings.add(symbolName(sc->organization));
+        r.location = strings.add(sc->location);
+        appendRecord(sections[DATA_STORAGE_CENTERS], r);
+        header.counts[DATA_STORAGE_CENTERS]++;
+    }
+
+    // Layout: header, record arrays and transport lines (8-byte aligned), string table
+    uint64_t offset = sizeof(SnapshotHeader);
+    for (int i = 0; i < DATA_COLLECTION_COUNT; i++) {
+        header.offsets[i] = offset;
+        offset = (offset + sections[i].length() + 7) & ~7ULL;
+    }
+    header.transportLinesOffset = offset;
+    offset = (offset + transportLineSection.length() + 7) & ~7ULL;
+    header.stringsOffset = offset;
+    header.stringsSize = strings.bytes.length();
+    header.fileSize = offset + strings.bytes.length();
+
+    out.assign((size_t)header.fileSize, '\0');
+    for (int i = 0; i < DATA_COLLECTION_COUNT; i++) {
+        if (!sections[i].empty()) memcpy(&out[(size_t)header.offsets[i]], sections[i].data(), sections[i].length());
     }
+    if (!transportLineSection.empty()) {
+        memcpy(&out[(size_t)header.transportLinesOffset], transportLineSection.data(), transportLineSection.length());
+    }
+    if (!strings.bytes.empty()) memcpy(&out[(size_t)header.stringsOffset], strings.bytes.data(), strings.bytes.length());
+    header.checksum = snapshotChecksum(out.data() + sizeof(SnapshotHeader), out.length() - sizeof(SnapshotHeader));
+    memcpy(&out[0], &header, sizeof(SnapshotHeader));
 }
 
-void loadStorageRequestsFromJSON() {
-    try {
-        ifstream file("data/storage_requests.json");
-        if (!file.is_open()) {
-            cout << "[JSON] No existing storage_requests.json found. Starting fresh.\n";
-            return;
-        }
+// Read-only view of a whole file
+struct MappedFile {
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE file;
+    HANDLE mapping;
+#else
+    int fd;
+#endif
+};
+
+bool mapFile(const char* path, MappedFile& mapped) {
+    mapped.data = nullptr;
+    mapped.size = 0;
+#ifdef _WIN32
+    mapped.mapping = nullptr;
+    mapped.file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (mapped.file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(mapped.file, &size) || size.QuadPart == 0) {
+        CloseHandle(mapped.file);
+        return false;
+    }
+    mapped.mapping = CreateFileMappingA(mapped.file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapped.mapping != nullptr) mapped.data = (const char*)MapViewOfFile(mapped.mapping, FILE_MAP_READ, 0, 0, 0);
+    if (mapped.data == nullptr) {
+        if (mapped.mapping != nullptr) CloseHandle(mapped.mapping);
+        CloseHandle(mapped.file);
+        return false;
+    }
+    mapped.size = (size_t)size.QuadPart;
+#else
+    mapped.fd = open(path, O_RDONLY);
+    if (mapped.fd < 0) return false;
+    struct stat info;
+    if (fstat(mapped.fd, &info) != 0 || info.st_size == 0) {
+        close(mapped.fd);
+        return false;
+    }
+    void* view = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, mapped.fd, 0);
+    if (view == MAP_FAILED) {
+        close(mapped.fd);
+        return false;
+    }
+    madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+    mapped.data = (const char*)view;
+    mapped.size = (size_t)info.st_size;
+#endif
+    return true;
+}
 
-        stringstream buffer;
-        buffer << file.rdbuf();
-        string json = buffer.str();
-        file.close();
-
-        size_t pos = 0;
-        int count = 0;
-        while ((pos = json.find("\"requestId\"", pos)) != string::npos) {
-            size_t objStart = json.rfind('{', pos);
-            size_t objEnd = json.find('}', pos);
-            if (objStart == string::npos || objEnd == string::npos) break;
-
-            string obj = json.substr(objStart, objEnd - objStart + 1);
-
-            StorageRequest* newReq = new StorageRequest;
-            newReq->requestId = stoi(extractJSONValue(obj, "requestId", false));
-            newReq->cropId = stoi(extractJSONValue(obj, "cropId", false));
-            newReq->quantity = stoi(extractJSONValue(obj, "quantity", false));
-            newReq->budget = stoi(extractJSONValue(obj, "budget", false));
-            newReq->pricePerKg = stoi(extractJSONValue(obj, "pricePerKg", false));
-            newReq->cropName = extractJSONValue(obj, "cropName", true);
-            newReq->organization = extractJSONValue(obj, "organization", true);
-            newReq->accepted = extractJSONValue(obj, "accepted", false) == "true";
-            newReq->rejected = extractJSONValue(obj, "rejected", false) == "true";
-            newReq->requesterId = stoi(extractJSONValue(obj, "requesterId", false));
-            newReq->next = nullptr;
-
-            addStorageRequest(newReq);
-            count++;
-            pos = objEnd + 1;
-        }
+void unmapFile(MappedFile& mapped) {
+    if (mapped.data == nullptr) return;
+#ifdef _WIN32
+    UnmapViewOfFile(mapped.data);
+    CloseHandle(mapped.mapping);
+    CloseHandle(mapped.file);
+#else
+    munmap((void*)mapped.data, mapped.size);
+    close(mapped.fd);
+#endif
+    mapped.data = nullptr;
+}
 
-        cout << "[JSON] Loaded " << count << " storage requests from data/storage_requests.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to load storage requests: " << e.what() << "\n";
+// Resolves string references against the mapped string table
+struct BinaryStringReader {
+    const char* base;
+    uint64_t size;
+
+    string operator()(const BinString& ref) const {
+        if ((uint64_t)ref.offset + ref.length > size) throw runtime_error("string reference out of range");
+        return string(base + ref.offset, ref.length);
+    }
+
+    // Strings are stored once, so a reference can stand in for the text
+    // (an empty string may share its offset with the next one, hence the
+    // length in the key); each loader thread has its own copy of the reader
+    // and of this cache
+    mutable unordered_map<uint64_t, Symbol> symbols;
+
+    Symbol symbol(const BinString& ref) const {
+        uint64_t key = ((uint64_t)ref.offset << 32) | ref.length;
+        auto it = symbols.find(key);
+        if (it != symbols.end()) return it->second;
+        Symbol symbol = intern((*this)(ref));
+        symbols[key] = symbol;
+        return symbol;
     }
+};
+
+void readUserRecord(User* user, const UserRecord& r, const BinaryStringReader& str) {
+    user->userId = r.userId;
+    user->username = str(r.username);
+    user->password = str(r.password);
+    user->role = (Role)str.symbol(r.role);
+    user->active = r.active != 0;
 }
 
-/* ==================== VEHICLES ==================== */
+void readCropRecord(Crop* crop, const CropRecord& r, const BinaryStringReader& str) {
+    crop->cropId = r.cropId;
+    cropFarmerId(crop) = r.farmerId;
+    cropQuantity(crop) = r.quantity;
+    crop->storageQuantity = r.storageQuantity;
+    cropPrice(crop) = r.pricePerKg;
+    crop->dateAdded = unpackDate(r.dateAdded);
+    crop->expiryDate = unpackDate(r.expiryDate);
+    cropType(crop) = str.symbol(r.cropType);
+    crop->quality = (Quality)str.symbol(r.quality);
+    crop->storageCenter = str(r.storageCenter);
+    cropAvailable(crop) = r.available != 0;
+}
+
+void readOrderRecord(Order* order, const OrderRecord& r, const BinaryStringReader&) {
+    order->orderId = r.orderId;
+    order->cropId = r.cropId;
+    order->buyerId = r.buyerId;
+    order->farmerId = r.farmerId;
+    order->quantity = r.quantity;
+    order->orderDate = unpackDate(r.orderDate);
+    order->farmerApproved = r.farmerApproved != 0;
+    order->paid = r.paid != 0;
+    order->delivered = r.delivered != 0;
+}
 
-void saveVehiclesToJSON() {
+void readTransportRequestRecord(TransportRequest* req, const TransportRequestRecord& r, const BinaryStringReader& str) {
+    req->requestId = r.requestId;
+    req->weight = r.weight;
+    req->distance = r.distance;
+    req->budget = r.budget;
+    req->requesterId = r.requesterId;
+    req->organization = str.symbol(r.organization);
+    req->accepted = r.accepted != 0;
+    req->rejected = r.rejected != 0;
+    req->completed = r.completed != 0;
+}
+
+void readStorageRequestRecord(StorageRequest* req, const StorageRequestRecord& r, const BinaryStringReader& str) {
+    req->requestId = r.requestId;
+    req->cropId = r.cropId;
+    req->quantity = r.quantity;
+    req->budget = r.budget;
+    req->pricePerKg = r.pricePerKg;
+    req->requesterId = r.requesterId;
+    req->cropName = str(r.cropName);
+    req->organization = str.symbol(r.organization);
+    req->accepted = r.accepted != 0;
+    req->rejected = r.rejected != 0;
+}
+
+void readVehicleRecord(Vehicle* vehicle, const VehicleRecord& r, const BinaryStringReader& str) {
+    vehicle->vehicleId = r.vehicleId;
+    vehicle->capacity = r.capacity;
+    vehicle->type = str(r.type);
+    vehicle->organization = str.symbol(r.organization);
+    vehicle->available = r.available != 0;
+}
+
+void readStorageCenterRecord(StorageCenter* center, const StorageCenterRecord& r, const BinaryStringReader& str) {
+    center->totalCapacity = r.totalCapacity;
+    center->availableCapacity = r.availableCapacity;
+    center->pricePerKg = r.pricePerKg;
+    center->temperature = r.temperature;
+    center->organization = str.symbol(r.organization);
+    center->location = str(r.location);
+}
+
+// Build detached nodes from one record array; a bad string reference (only
+// possible from a writer bug, the checksum having passed) stops the array there
+template <typename T, typename Record>
+ParsedFile<T> buildFromRecords(const char* records, uint32_t count, BinaryStringReader str,
+                               void (*read)(T*, const Record&, const BinaryStringReader&)) {
+    ParsedFile<T> built;
+    built.found = true;
+    built.items.reserve(count);
     try {
-        ofstream file("data/vehicles.json");
-        if (!file.is_open()) {
-            cerr << "[JSON ERROR] Cannot open data/vehicles.json for writing.\n";
-            return;
+        for (uint32_t i = 0; i < count; i++) {
+            T* item = newNode<T>();
+            built.items.push_back(item);
+            read(item, ((const Record*)records)[i], str);
         }
+    } catch (const exception& e) {
+        deleteNode(built.items.back());  // the half-read record
+        built.items.pop_back();
+        built.error = e.what();
+    }
+    return built;
+}
 
-        file << "[\n";
-        Vehicle* curr = vehicleHead;
-        bool first = true;
-        int count = 0;
-
-        while (curr != nullptr) {
-            if (!first) file << ",\n";
-            first = false;
-
-            file << "  {\n";
-            file << "    \"vehicleId\": " << curr->vehicleId << ",\n";
-            file << "    \"capacity\": " << curr->capacity << ",\n";
-            file << "    \"available\": " << (curr->available ? "true" : "false") << ",\n";
-            file << "    \"type\": \"" << escapeJSON(curr->type) << "\",\n";
-            file << "    \"organization\": \"" << escapeJSON(curr->organization) << "\"\n";
-            file << "  }";
-
-            curr = curr->next;
-            count++;
-        }
+template <typename T>
+void reportBuildError(const ParsedFile<T>& built, DataCollection collection) {
+    if (!built.error.empty()) {
+        cerr << "[SNAPSHOT ERROR] Failed to load " << COLLECTION_NAMES[collection] << " from "
+             << BINARY_SNAPSHOT_PATH << ": " << built.error << "\n";
+    }
+}
 
-        file << "\n]\n";
-        file.close();
-        cout << "[JSON] Saved " << count << " vehicles to data/vehicles.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to save vehicles: " << e.what() << "\n";
+// Load every collection from data/snapshot.bin. Nothing is touched unless
+// the header and checksum check out, so a false return leaves the JSON
+// files to be loaded instead. Record arrays are turned into nodes in
+// parallel, then linked like parsed JSON (see PARALLEL LOADING).
+bool loadBinarySnapshot() {
+    MappedFile mapped;
+    if (!mapFile(BINARY_SNAPSHOT_PATH, mapped)) return false;
+
+    SnapshotHeader header = {};
+    bool valid = mapped.size >= SNAPSHOT_V1_HEADER_SIZE;
+    if (valid) {
+        memcpy(&header, mapped.data, SNAPSHOT_V1_HEADER_SIZE);
+        valid = memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) == 0 &&
+                ((header.version == 1 && header.headerSize == SNAPSHOT_V1_HEADER_SIZE) ||
+                 ((header.version == 2 || header.version == SNAPSHOT_VERSION) && header.headerSize == sizeof(SnapshotHeader))) &&
+                header.fileSize == mapped.size && header.headerSize <= mapped.size &&
+                header.stringsOffset + header.stringsSize <= mapped.size;
+    }
+    size_t lineSize = (header.version == 2) ? sizeof(TransportLineRecordV2) : sizeof(TransportLineRecord);
+    if (valid) {
+        memcpy(&header, mapped.data, header.headerSize);  // version 1 leaves the line fields zero
+        valid = header.transportLinesOffset % 8 == 0 &&
+                header.transportLinesOffset + (uint64_t)header.transportLineCount * lineSize <= header.stringsOffset;
+    }
+    const size_t recordSizes[DATA_COLLECTION_COUNT] = {
+        sizeof(UserRecord), sizeof(CropRecord), sizeof(OrderRecord), sizeof(TransportRequestRecord),
+        sizeof(StorageRequestRecord), sizeof(VehicleRecord), sizeof(StorageCenterRecord)
+    };
+    for (int i = 0; valid && i < DATA_COLLECTION_COUNT; i++) {
+        valid = header.offsets[i] % 8 == 0 && header.offsets[i] + (uint64_t)header.counts[i] * recordSizes[i] <= header.stringsOffset;
+    }
+    if (!valid) {
+        cerr << "[SNAPSHOT ERROR] " << BINARY_SNAPSHOT_PATH << " is not a version 1-" << SNAPSHOT_VERSION << " snapshot; loading JSON instead.\n";
+        unmapFile(mapped);
+        return false;
     }
+    if (snapshotChecksum(mapped.data + header.headerSize, mapped.size - header.headerSize) != header.checksum) {
+        cerr << "[SNAPSHOT ERROR] Checksum mismatch in " << BINARY_SNAPSHOT_PATH << "; loading JSON instead.\n";
+        unmapFile(mapped);
+        return false;
+    }
+
+    BinaryStringReader str = { mapped.data + header.stringsOffset, header.stringsSize, {} };
+    const char* base = mapped.data;
+    LoadedData data;
+    auto users = async(launch::async, buildFromRecords<User, UserRecord>,
+                       base + header.offsets[DATA_USERS], header.counts[DATA_USERS], str, readUserRecord);
+    auto crops = async(launch::async, buildFromRecords<Crop, CropRecord>,
+                       base + header.offsets[DATA_CROPS], header.counts[DATA_CROPS], str, readCropRecord);
+    auto orders = async(launch::async, buildFromRecords<Order, OrderRecord>,
+                        base + header.offsets[DATA_ORDERS], header.counts[DATA_ORDERS], str, readOrderRecord);
+    auto transportRequests = async(launch::async, buildFromRecords<TransportRequest, TransportRequestRecord>,
+                                   base + header.offsets[DATA_TRANSPORT_REQUESTS], header.counts[DATA_TRANSPORT_REQUESTS], str, readTransportRequestRecord);
+    auto storageRequests = async(launch::async, buildFromRecords<StorageRequest, StorageRequestRecord>,
+                                 base + header.offsets[DATA_STORAGE_REQUESTS], header.counts[DATA_STORAGE_REQUESTS], str, readStorageRequestRecord);
+    auto vehicles = async(launch::async, buildFromRecords<Vehicle, VehicleRecord>,
+                          base + header.offsets[DATA_VEHICLES], header.counts[DATA_VEHICLES], str, readVehicleRecord);
+    data.storageCenters = buildFromRecords<StorageCenter, StorageCenterRecord>(
+        base + header.offsets[DATA_STORAGE_CENTERS], header.counts[DATA_STORAGE_CENTERS], str, readStorageCenterRecord);
+    data.users = users.get();
+    data.crops = crops.get();
+    data.orders = orders.get();
+    data.transportRequests = transportRequests.get();
+    data.storageRequests = storageRequests.get();
+    data.vehicles = vehicles.get();
+
+    const char* lines = base + header.transportLinesOffset;
+    for (uint32_t i = 0; i < header.transportLineCount; i++) {
+        TransportLineRecord line = {};
+        memcpy(&line, lines + i * lineSize, lineSize);  // a version 2 line leaves orderId 0
+        if (line.request >= data.transportRequests.items.size()) continue;  // request not loaded
+        addTransportLine(data.transportRequests.items[line.request], line.cropId, line.quantity, line.orderId);
+    }
+    unmapFile(mapped);
+
+    reportBuildError(data.users, DATA_USERS);
+    reportBuildError(data.crops, DATA_CROPS);
+    reportBuildError(data.orders, DATA_ORDERS);
+    reportBuildError(data.transportRequests, DATA_TRANSPORT_REQUESTS);
+    reportBuildError(data.storageRequests, DATA_STORAGE_REQUESTS);
+    reportBuildError(data.vehicles, DATA_VEHICLES);
+    reportBuildError(data.storageCenters, DATA_STORAGE_CENTERS);
+    cout << "[SNAPSHOT] Loaded " << data.users.items.size() << " users, " << data.crops.items.size() << " crops, "
+         << data.orders.items.size() << " orders, " << data.transportRequests.items.size() << " transport requests, "
+         << data.storageRequests.items.size() << " storage requests, " << data.vehicles.items.size() << " vehicles, "
+         << data.storageCenters.items.size() << " storage centers from " << BINARY_SNAPSHOT_PATH << "\n";
+    linkLoadedData(data);
+    validateReferences(data);
+    return true;
 }
 
-void loadVehiclesFromJSON() {
-    try {
-        ifstream file("data/vehicles.json");
-        if (!file.is_open()) {
-            cout << "[JSON] No existing vehicles.json found. Starting fresh.\n";
-            return;
-        }
+/* ==================== WRITE-AHEAD LOG ====================
+ * Mutations append one compact JSON line per touched entity to data/wal.log
+ * instead of rewriting every snapshot file. Each record is a full upsert
+ * ({"op":"order", ...same fields as orders.json}), so replaying a record
+ * twice is harmless. Records from one user action are buffered and handed
+ * to the persistence worker together by walCommit(). Once more than
+ * WAL_COMPACT_BYTES (or the size left by the last compaction, if larger)
+ * has been appended, walCommit() asks the worker to compact the log down to
+ * the newest record of each entity, off the caller's thread. saveAllData()
+ * folds the log into the snapshots and has the worker truncate it. On
+ * startup loadAllData() reads the snapshots and replays the log on top; a
+ * torn final line from a crash is discarded.
+ */
+
+const char* WAL_PATH = "data/wal.log";
+const long long WAL_COMPACT_BYTES = 1024 * 1024;
+const int WAL_SYNC_INTERVAL_MS = 200;
+
+WalSyncPolicy walSyncPolicy = WAL_SYNC_ALWAYS;
+string walPending;               // records logged since the last commit
+long long walBytes = 0;          // log bytes committed since the last snapshot or compaction
+atomic<long long> walCompactedBytes(0);  // log size the worker's last compaction left
+
+void setWalSyncPolicy(WalSyncPolicy policy) {
+    walSyncPolicy = policy;
+}
 
-        stringstream buffer;
-        buffer << file.rdbuf();
-        string json = buffer.str();
-        file.close();
-
-        size_t pos = 0;
-        int count = 0;
-        while ((pos = json.find("\"vehicleId\"", pos)) != string::npos) {
-            size_t objStart = json.rfind('{', pos);
-            size_t objEnd = json.find('}', pos);
-            if (objStart == string::npos || objEnd == string::npos) break;
-
-            string obj = json.substr(objStart, objEnd - objStart + 1);
-
-            Vehicle* newVehicle = new Vehicle;
-            newVehicle->vehicleId = stoi(extractJSONValue(obj, "vehicleId", false));
-            newVehicle->capacity = stoi(extractJSONValue(obj, "capacity", false));
-            newVehicle->available = extractJSONValue(obj, "available", false) == "true";
-            newVehicle->type = extractJSONValue(obj, "type", true);
-            newVehicle->organization = extractJSONValue(obj, "organization", true);
-            newVehicle->next = nullptr;
-
-            addVehicle(newVehicle);
-            count++;
-            pos = objEnd + 1;
-        }
+// Queue one record: the op tag followed by the entity's snapshot fields
+void walRecord(const string& op, const function<void(JsonObjectWriter&)>& writeFields) {
+    stringstream line;
+    JsonObjectWriter w(line, false);
+    w.stringField("op", op);
+    writeFields(w);
+    w.end();
+    walPending += line.str();
+    walPending += '\n';
+}
 
-        cout << "[JSON] Loaded " << count << " vehicles from data/vehicles.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to load vehicles: " << e.what() << "\n";
+void walLogUser(User* user) { markDirty(DATA_USERS); walRecord("user", [&](JsonObjectWriter& w) { writeUserFields(w, user); }); }
+void walLogCrop(Crop* crop) { markDirty(DATA_CROPS); walRecord("crop", [&](JsonObjectWriter& w) { writeCropFields(w, crop); }); }
+void walLogOrder(Order* order) { markDirty(DATA_ORDERS); walRecord("order", [&](JsonObjectWriter& w) { writeOrderFields(w, order); }); }
+void walLogTransportRequest(TransportRequest* req) { markDirty(DATA_TRANSPORT_REQUESTS); walRecord("transport", [&](JsonObjectWriter& w) { writeTransportRequestFields(w, req); }); }
+void walLogStorageRequest(StorageRequest* req) { markDirty(DATA_STORAGE_REQUESTS); walRecord("storage", [&](JsonObjectWriter& w) { writeStorageRequestFields(w, req); }); }
+void walLogVehicle(Vehicle* vehicle) { markDirty(DATA_VEHICLES); walRecord("vehicle", [&](JsonObjectWriter& w) { writeVehicleFields(w, vehicle); }); }
+void walLogStorageCenter(StorageCenter* center) { markDirty(DATA_STORAGE_CENTERS); walRecord("center", [&](JsonObjectWriter& w) { writeStorageCenterFields(w, center); }); }
+
+/* ==================== PERSISTENCE WORKER ====================
+ * All disk I/O happens on one background thread. Callers serialize on their
+ * own thread (the in-memory structures are not shared) and queue the bytes:
+ * walCommit() queues log records, saveAllData() queues snapshot files. The
+ * worker waits PERSIST_COALESCE_MS after the first job so a burst (say 50
+ * orders in a second) becomes one write + one fsync, keeps only the newest
+ * copy of each snapshot file in a batch, and truncates the log only after
+ * every snapshot in the batch is safely renamed into place. flushPersistence()
+ * blocks until the queue is empty and stops the worker, for clean shutdown.
+ */
+
+const int PERSIST_COALESCE_MS = 20;
+
+struct SnapshotFile {
+    string path;
+    string content;
+};
+
+struct PersistJob {
+    string walRecords;               // appended to data/wal.log
+    vector<SnapshotFile> snapshot;   // written atomically, then the log is truncated
+    vector<string> obsolete;         // deleted once the snapshot is in place
+    bool isSnapshot;
+    bool compactLog = false;         // compact data/wal.log once the records are appended
+};
+
+mutex persistLock;
+condition_variable persistWake;      // worker: jobs queued or stop requested
+condition_variable persistIdle;      // flushPersistence: queue drained
+vector<PersistJob> persistQueue;
+thread persistThread;
+bool persistRunning = false;
+bool persistStopping = false;
+bool persistBusy = false;
+atomic<bool> snapshotWriteFailed(false);
+PersistenceStats persistStats = { 0, 0, 0, 0, 0.0, 0.0, 0.0 };
+
+// Worker-owned log handle
+FILE* walFile = nullptr;
+chrono::steady_clock::time_point walLastSync;
+
+bool openWAL() {
+    if (walFile != nullptr) return true;
+    ensureDataFolder();
+    walFile = fopen(WAL_PATH, "ab");
+    if (walFile == nullptr) {
+        cerr << "[WAL ERROR] Cannot open " << WAL_PATH << " for appending.\n";
+        return false;
     }
+    return true;
 }
 
-/* ==================== STORAGE CENTERS ==================== */
+void closeWAL() {
+    if (walFile != nullptr) fclose(walFile);
+    walFile = nullptr;
+}
+
+void syncWAL() {
+    fflush(walFile);
+#ifdef _WIN32
+    _commit(_fileno(walFile));
+#else
+    fsync(fileno(walFile));
+#endif
+    walLastSync = chrono::steady_clock::now();
+}
+
+long long appendWAL(const string& records) {
+    if (records.empty() || !openWAL()) return 0;
+    size_t written = fwrite(records.data(), 1, records.length(), walFile);
+    if (walSyncPolicy == WAL_SYNC_ALWAYS) {
+        syncWAL();
+    } else if (walSyncPolicy == WAL_SYNC_BATCHED) {
+        auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - walLastSync);
+        if (elapsed.count() >= WAL_SYNC_INTERVAL_MS) syncWAL();
+        else fflush(walFile);
+    } else {
+        fflush(walFile);
+    }
+    return (long long)written;
+}
 
-void saveStorageCentersToJSON() {
+// Empty the log once the snapshots hold everything in it
+void truncateWAL() {
+    closeWAL();
+    error_code ec;
+    if (fs::exists(WAL_PATH, ec)) fs::resize_file(WAL_PATH, 0, ec);
+    walCompactedBytes = 0;
+}
+
+bool writeSnapshotFile(const SnapshotFile& file) {
+    ofstream out(file.path + ".tmp", ios::binary);
+    if (!out.is_open()) {
+        cerr << "[JSON ERROR] Cannot open " << file.path << ".tmp for writing.\n";
+        return false;
+    }
+    out.write(file.content.data(), (streamsize)file.content.length());
+    out.close();
+    if (!out || !commitSnapshotFile(file.path)) {
+        cerr << "[JSON ERROR] Failed to write " << file.path << "\n";
+        return false;
+    }
+    return true;
+}
+
+// Rewrite the log keeping only the newest record of each entity. Every record
+// is a full upsert keyed by its op and first field (the entity's id), so
+// replaying what is left, in the original order, ends in the same state as
+// replaying all of it. Reads no shared structures, so it runs on the worker.
+// A log it cannot parse is left for replayWAL to report.
+long long compactWAL() {
+    closeWAL();
+    ifstream log(WAL_PATH, ios::binary);
+    if (!log.is_open()) return 0;
+    vector<string> lines;
+    vector<string> keys;
+    unordered_map<string, size_t> newest;
+    string line;
     try {
-        ofstream file("data/storage_centers.json");
-        if (!file.is_open()) {
-            cerr << "[JSON ERROR] Cannot open data/storage_centers.json for writing.\n";
-            return;
+        while (getline(log, line)) {
+            if (log.eof()) break;  // torn final record: replay drops it too
+            JsonStreamReader reader(line);
+            if (!reader.nextObject() || !reader.nextField()) throw runtime_error("record has no op");
+            string key = reader.value;
+            if (!reader.nextField()) throw runtime_error("record has no id");
+            key += '\n';
+            key += reader.value;
+            newest[key] = lines.size();
+            lines.push_back(move(line));
+            keys.push_back(move(key));
         }
+    } catch (const exception& e) {
+        cerr << "[WAL ERROR] Not compacting " << WAL_PATH << ": " << e.what() << "\n";
+        return 0;
+    }
+    log.close();
+
+    SnapshotFile compacted = { WAL_PATH, "" };
+    for (size_t i = 0; i < lines.size(); i++) {
+        if (newest[keys[i]] != i) continue;
+        compacted.content += lines[i];
+        compacted.content += '\n';
+    }
+    if (!writeSnapshotFile(compacted)) return 0;
+    walCompactedBytes = (long long)compacted.content.length();
+    return (long long)compacted.content.length();
+}
 
-        file << "[\n";
-        StorageCenter* curr = storageCenterHead;
-        bool first = true;
-        int count = 0;
-
-        while (curr != nullptr) {
-            if (!first) file << ",\n";
-            first = false;
-
-            file << "  {\n";
-            file << "    \"organization\": \"" << escapeJSON(curr->organization) << "\",\n";
-            file << "    \"totalCapacity\": " << curr->totalCapacity << ",\n";
-            file << "    \"availableCapacity\": " << curr->availableCapacity << ",\n";
-            file << "    \"temperature\": " << fixed << setprecision(1) << curr->temperature << ",\n";
-            file << "    \"location\": \"" << escapeJSON(curr->location) << "\",\n";
-            file << "    \"pricePerKg\": " << curr->pricePerKg << "\n";
-            file << "  }";
-
-            curr = curr->next;
-            count++;
+// Write one coalesced batch, preserving the order of log appends and snapshots
+long long processPersistBatch(vector<PersistJob>& batch) {
+    int lastSnapshot = -1;
+    for (int i = 0; i < (int)batch.size(); i++) {
+        if (batch[i].isSnapshot) lastSnapshot = i;
+    }
+
+    long long bytes = 0;
+    string records;
+    if (lastSnapshot >= 0) {
+        // Later copies of a file replace earlier ones; the log written so far
+        // is only dropped once every file is in place
+        vector<SnapshotFile*> latest;
+        vector<string> obsolete;
+        for (int i = 0; i <= lastSnapshot; i++) {
+            records += batch[i].walRecords;
+            obsolete.insert(obsolete.end(), batch[i].obsolete.begin(), batch[i].obsolete.end());
+            for (size_t f = 0; f < batch[i].snapshot.size(); f++) {
+                SnapshotFile* file = &batch[i].snapshot[f];
+                size_t j = 0;
+                while (j < latest.size() && latest[j]->path != file->path) j++;
+                if (j == latest.size()) latest.push_back(file);
+                else latest[j] = file;
+            }
         }
+        bytes += appendWAL(records);
+        records.clear();
 
-        file << "\n]\n";
-        file.close();
-        cout << "[JSON] Saved " << count << " storage centers to data/storage_centers.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to save storage centers: " << e.what() << "\n";
+        bool ok = true;
+        for (size_t j = 0; j < latest.size(); j++) {
+            if (writeSnapshotFile(*latest[j])) bytes += (long long)latest[j]->content.length();
+            else ok = false;
+        }
+        if (ok) {
+            for (size_t j = 0; j < obsolete.size(); j++) {
+                bool rewritten = false;
+                for (size_t k = 0; k < latest.size(); k++) rewritten = rewritten || latest[k]->path == obsolete[j];
+                error_code ec;
+                if (!rewritten) fs::remove(obsolete[j], ec);
+            }
+            truncateWAL();
+        } else {
+            snapshotWriteFailed = true;
+        }
+    }
+    bool compact = false;
+    for (int i = lastSnapshot + 1; i < (int)batch.size(); i++) {
+        records += batch[i].walRecords;
+        compact = compact || batch[i].compactLog;
     }
+    bytes += appendWAL(records);
+    if (compact) bytes += compactWAL();
+    return bytes;
 }
 
-void loadStorageCentersFromJSON() {
-    try {
-        ifstream file("data/storage_centers.json");
-        if (!file.is_open()) {
-            cout << "[JSON] No existing storage_centers.json found. Starting fresh.\n";
-            return;
+void runPersistenceWorker() {
+    unique_lock<mutex> lock(persistLock);
+    while (true) {
+        persistWake.wait(lock, [] { return !persistQueue.empty() || persistStopping; });
+        if (persistQueue.empty()) break;  // stopping and drained
+        if (!persistStopping) {
+            // Let the rest of a burst arrive so it shares one write and one fsync
+            persistWake.wait_for(lock, chrono::milliseconds(PERSIST_COALESCE_MS), [] { return persistStopping; });
         }
+        vector<PersistJob> batch;
+        batch.swap(persistQueue);
+        persistBusy = true;
+        lock.unlock();
+
+        auto start = chrono::steady_clock::now();
+        long long bytes = processPersistBatch(batch);
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+        lock.lock();
+        persistBusy = false;
+        persistStats.flushes++;
+        persistStats.jobs += (long long)batch.size();
+        persistStats.bytesWritten += bytes;
+        persistStats.lastFlushMs = ms;
+        persistStats.totalFlushMs += ms;
+        if (ms > persistStats.maxFlushMs) persistStats.maxFlushMs = ms;
+        if (persistQueue.empty()) persistIdle.notify_all();
+    }
+    closeWAL();
+}
+
+void enqueuePersistJob(PersistJob&& job) {
+    lock_guard<mutex> lock(persistLock);
+    if (!persistRunning) {
+        persistStopping = false;
+        persistThread = thread(runPersistenceWorker);
+        persistRunning = true;
+    }
+    persistQueue.push_back(move(job));
+    persistWake.notify_one();
+}
+
+// Block until everything queued is on disk, then stop the worker
+void flushPersistence() {
+    {
+        lock_guard<mutex> lock(persistLock);
+        if (!persistRunning) return;
+        persistStopping = true;
+        persistWake.notify_one();
+    }
+    persistThread.join();
+    lock_guard<mutex> lock(persistLock);
+    persistRunning = false;
+    persistStopping = false;
+}
 
-        stringstream buffer;
-        buffer << file.rdbuf();
-        string json = buffer.str();
-        file.close();
-
-        size_t pos = 0;
-        int count = 0;
-        while ((pos = json.find("\"organization\"", pos)) != string::npos) {
-            size_t objStart = json.rfind('{', pos);
-            size_t objEnd = json.find('}', pos);
-            if (objStart == string::npos || objEnd == string::npos) break;
-
-            string obj = json.substr(objStart, objEnd - objStart + 1);
-
-            StorageCenter* newCenter = new StorageCenter;
-            newCenter->organization = extractJSONValue(obj, "organization", true);
-            newCenter->totalCapacity = stoi(extractJSONValue(obj, "totalCapacity", false));
-            newCenter->availableCapacity = stoi(extractJSONValue(obj, "availableCapacity", false));
-            newCenter->temperature = stof(extractJSONValue(obj, "temperature", false));
-            newCenter->location = extractJSONValue(obj, "location", true);
-            newCenter->pricePerKg = stoi(extractJSONValue(obj, "pricePerKg", false));
-            newCenter->next = nullptr;
-
-            addStorageCenter(newCenter);
-            count++;
-            pos = objEnd + 1;
+PersistenceStats getPersistenceStats() {
+    lock_guard<mutex> lock(persistLock);
+    PersistenceStats stats = persistStats;
+    stats.queueDepth = (int)persistQueue.size() + (persistBusy ? 1 : 0);
+    return stats;
+}
+
+void walCommit() {
+    if (walPending.empty()) return;
+    walBytes += (long long)walPending.length();
+    PersistJob job;
+    job.walRecords.swap(walPending);
+    job.isSnapshot = false;
+    // Compacting costs the size of the log, so wait until at least that much
+    // has been appended again; the caller only flags the job
+    job.compactLog = walBytes > max(WAL_COMPACT_BYTES, walCompactedBytes.load());
+    if (job.compactLog) walBytes = 0;
+    enqueuePersistJob(move(job));
+}
+
+// Overwrite an existing node with a replayed record, keeping its list/tree links
+template <typename T>
+void replaceKeepingNext(T* existing, T* replayed) {
+    T* next = existing->next;
+    *existing = *replayed;
+    existing->next = next;
+    deleteNode(replayed);
+}
+
+void applyWALRecord(const string& line) {
+    // walRecord() always writes the op tag first
+    JsonStreamReader reader(line);
+    if (!reader.nextObject() || !reader.nextField() || reader.key != "op") throw runtime_error("record has no op");
+    string op = reader.value;
+    if (op == "user") {
+        markDirty(DATA_USERS);
+        User* user = readObject(reader, setUserField);
+        User* existing = findUserById(user->userId);
+        if (existing == nullptr) {
+            insertUser(user);
+        } else {
+            existing->password = user->password;
+            existing->role = user->role;
+            existing->active = user->active;
+            deleteNode(user);
         }
+    } else if (op == "crop") {
+        markDirty(DATA_CROPS);
+        Crop* crop = readObject(reader, setCropField);
+        Crop* existing = findCropById(crop->cropId);
+        if (existing == nullptr) {
+            insertCrop(crop);
+        } else {
+            // Listed prices never change, so the node keeps its place in the price tree
+            Crop* left = existing->left;
+            Crop* right = existing->right;
+            int height = existing->height;
+            copyCrop(existing, crop);
+            existing->left = left;
+            existing->right = right;
+            existing->height = height;
+            deleteNode(crop);
+        }
+    } else if (op == "order") {
+        markDirty(DATA_ORDERS);
+        Order* order = readObject(reader, setOrderField);
+        Order* existing = findOrderById(order->orderId);
+        if (existing == nullptr) {
+            addOrder(order);
+        } else {
+            replaceOrder(existing, order);
+            deleteNode(order);
+        }
+    } else if (op == "transport") {
+        markDirty(DATA_TRANSPORT_REQUESTS);
+        TransportRequest* req = readObject(reader, setTransportRequestField);
+        TransportRequest* existing = findTransportRequestById(req->requestId);
+        if (existing == nullptr) addTransportRequest(req);
+        else replaceKeepingNext(existing, req);
+    } else if (op == "storage") {
+        markDirty(DATA_STORAGE_REQUESTS);
+        StorageRequest* req = readObject(reader, setStorageRequestField);
+        StorageRequest* existing = findStorageRequestById(req->requestId);
+        if (existing == nullptr) addStorageRequest(req);
+        else replaceKeepingNext(existing, req);
+    } else if (op == "vehicle") {
+        markDirty(DATA_VEHICLES);
+        Vehicle* vehicle = readObject(reader, setVehicleField);
+        Vehicle* existing = findVehicleById(vehicle->vehicleId);
+        if (existing == nullptr) addVehicle(vehicle);
+        else replaceKeepingNext(existing, vehicle);
+    } else if (op == "center") {
+        markDirty(DATA_STORAGE_CENTERS);
+        StorageCenter* center = readObject(reader, setStorageCenterField);
+        StorageCenter* existing = findStorageCenter(center->organization);
+        if (existing == nullptr) addStorageCenter(center);
+        else replaceKeepingNext(existing, center);
+    } else {
+        throw runtime_error("unknown record type '" + op + "'");
+    }
+}
 
-        cout << "[JSON] Loaded " << count << " storage centers from data/storage_centers.json\n";
-    } catch (const exception& e) {
-        cerr << "[JSON ERROR] Failed to load storage centers: " << e.what() << "\n";
+void replayWAL() {
+    ifstream log(WAL_PATH, ios::binary);
+    if (!log.is_open()) return;
+
+    long long pos = 0;
+    int count = 0;
+    string line;
+    while (getline(log, line)) {
+        if (log.eof()) break;  // torn final record: never committed
+        try {
+            applyWALRecord(line);
+        } catch (const exception& e) {
+            cerr << "[WAL ERROR] Bad record at byte " << pos << ": " << e.what() << "\n";
+            break;
+        }
+        count++;
+        pos += (long long)line.length() + 1;
     }
+    log.close();
+
+    error_code ec;
+    long long logLength = (long long)fs::file_size(WAL_PATH, ec);
+    if (!ec && pos < logLength) {
+        // Drop the unreadable tail so new records are not appended after it
+        fs::resize_file(WAL_PATH, (uintmax_t)pos, ec);
+        cerr << "[WAL] Discarded " << (logLength - pos) << " bytes of incomplete log.\n";
+    }
+    walBytes = pos;
+    if (count > 0) cout << "[WAL] Replayed " << count << " records from " << WAL_PATH << "\n";
 }
 
 /* ==================== MASTER FUNCTIONS ==================== */
 
 void loadAllData() {
-    cout << "\n=============== LOADING DATA FROM JSON ===============\n";
+    cout << "\n================= LOADING SAVED DATA ================\n";
     ensureDataFolder();
-    loadUsersFromJSON();
-    loadCropsFromJSON();
-    loadOrdersFromJSON();
-    loadTransportRequestsFromJSON();
-    loadStorageRequestsFromJSON();
-    loadVehiclesFromJSON();
-    loadStorageCentersFromJSON();
+    clearAllData();  // so calling this again reloads instead of duplicating
+    error_code ec;
+    bool fromBinary = fs::exists(BINARY_SNAPSHOT_PATH, ec) && loadBinarySnapshot();
+    if (!fromBinary) loadJSONSnapshot();
+    markAllClean();
+    if (!snapshotFormatChosen) snapshotFormat = fromBinary ? SNAPSHOT_BINARY : SNAPSHOT_JSON;
+    // Switching back to JSON: every JSON file is older than snapshot.bin
+    if (fromBinary && snapshotFormat == SNAPSHOT_JSON) markAllDirty();
+    replayWAL();
     cout << "=====================================================\n\n";
 }
 
+// Snapshot every changed collection. Serialization happens here, on the
+// caller's thread; the persistence worker writes the files and then empties
+// the write-ahead log, which they make redundant.
 void saveAllData() {
-    cout << "\n=============== SAVING DATA TO JSON ===============\n";
-    ensureDataFolder();
-    saveUsersToJSON();
-    saveCropsToJSON();
-    saveOrdersToJSON();
-    saveTransportRequestsToJSON();
-    saveStorageRequestsToJSON();
-    saveVehiclesToJSON();
-    saveStorageCentersToJSON();
-    cout << "=================================================\n\n";
+    int (*writers[DATA_COLLECTION_COUNT])(ostream&) = {
+        writeUsersJSON, writeCropsJSON, writeOrdersJSON, writeTransportRequestsJSON,
+        writeStorageRequestsJSON, writeVehiclesJSON, writeStorageCentersJSON
+    };
+    // The worker could not write a file last time; resend everything
+    if (snapshotWriteFailed.exchange(false)) markAllDirty();
+
+    PersistJob job;
+    job.isSnapshot = true;
+    job.walRecords.swap(walPending);
+    error_code ec;
+    if (snapshotFormat == SNAPSHOT_BINARY) {
+        // One file holds every collection, so any change rewrites all of it
+        bool changed = !fs::exists(BINARY_SNAPSHOT_PATH, ec);
+        for (int i = 0; i < DATA_COLLECTION_COUNT; i++) changed = changed || collectionVersion[i] != savedVersion[i];
+        if (changed) {
+            SnapshotFile file = { BINARY_SNAPSHOT_PATH, "" };
+            writeBinarySnapshot(file.content);
+            job.snapshot.push_back(move(file));
+            markAllClean();
+        }
+    } else {
+        for (int i = 0; i < DATA_COLLECTION_COUNT; i++) {
+            if (!needsSave((DataCollection)i)) continue;
+            stringstream content;
+            writers[i](content);
+            job.snapshot.push_back({ COLLECTION_FILES[i], content.str() });
+            savedVersion[i] = collectionVersion[i];
+        }
+        if (fs::exists(BINARY_SNAPSHOT_PATH, ec)) job.obsolete.push_back(BINARY_SNAPSHOT_PATH);
+    }
+    if (job.snapshot.empty() && job.obsolete.empty() && job.walRecords.empty() && walBytes == 0) return;  // nothing to do
+    walBytes = 0;
+    enqueuePersistJob(move(job));
+}
+
+// --convert: load whichever format is current and rewrite the whole data
+// folder in the other one
+void convertSnapshot(SnapshotFormat target) {
+    setSnapshotFormat(target);
+    loadAllData();
+    markAllDirty();
+    saveAllData();
+    flushPersistence();
+    PersistenceStats stats = getPersistenceStats();
+    cout << "[SNAPSHOT] Wrote " << stats.bytesWritten << " bytes as "
+         << (target == SNAPSHOT_BINARY ? BINARY_SNAPSHOT_PATH : "JSON files") << "\n";
 }
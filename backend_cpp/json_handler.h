@@ -3,6 +3,7 @@
 
 #include <string>
 #include <vector>
+#include <ostream>
 
 using namespace std;
 
@@ -11,28 +12,93 @@ using namespace std;
 // Create data folder if it doesn't exist
 void ensureDataFolder();
 
-// Save functions
-void saveUsersToJSON();
-void saveCropsToJSON();
-void saveOrdersToJSON();
-void saveTransportRequestsToJSON();
-void saveStorageRequestsToJSON();
-void saveVehiclesToJSON();
-void saveStorageCentersToJSON();
-
-// Load functions
-void loadUsersFromJSON();
-void loadCropsFromJSON();
-void loadOrdersFromJSON();
-void loadTransportRequestsFromJSON();
-void loadStorageRequestsFromJSON();
-void loadVehiclesFromJSON();
-void loadStorageCentersFromJSON();
-
-// Load all data at startup
+// Serialize a whole collection in its data/*.json format; return the record count
+int writeUsersJSON(ostream& file);
+int writeCropsJSON(ostream& file);
+int writeOrdersJSON(ostream& file);
+int writeTransportRequestsJSON(ostream& file);
+int writeStorageRequestsJSON(ostream& file);
+int writeVehiclesJSON(ostream& file);
+int writeStorageCentersJSON(ostream& file);
+
+// One entry per data/*.json file; mutators call markDirty() so saveAllData()
+// can skip collections that have not changed
+enum DataCollection {
+    DATA_USERS,
+    DATA_CROPS,
+    DATA_ORDERS,
+    DATA_TRANSPORT_REQUESTS,
+    DATA_STORAGE_REQUESTS,
+    DATA_VEHICLES,
+    DATA_STORAGE_CENTERS,
+    DATA_COLLECTION_COUNT
+};
+
+void markDirty(DataCollection collection);
+
+// Load all data at startup: data/snapshot.bin if present, else the JSON
+// files. Collections are parsed in parallel, then linked on this thread.
 void loadAllData();
 
-// Save all data
+// Format saveAllData() writes. The binary snapshot (data/snapshot.bin) is a
+// checksummed, memory-mapped file that loads far faster than the JSON files.
+// Without a choice, the format that was loaded is kept.
+enum SnapshotFormat {
+    SNAPSHOT_JSON,
+    SNAPSHOT_BINARY
+};
+
+void setSnapshotFormat(SnapshotFormat format);
+
+// Load the data folder and rewrite all of it in the given format
+void convertSnapshot(SnapshotFormat target);
+
+// Queue a snapshot of all changed collections for the persistence worker
+// (which also empties the write-ahead log). Returns without waiting for disk.
 void saveAllData();
 
+// Block until every queued write is on disk; call before exiting
+void flushPersistence();
+
+struct PersistenceStats {
+    int queueDepth;         // jobs waiting or being written
+    long long flushes;      // batches written (one fsync each)
+    long long jobs;         // commits + snapshots those batches held
+    long long bytesWritten;
+    double lastFlushMs;
+    double maxFlushMs;
+    double totalFlushMs;
+};
+
+PersistenceStats getPersistenceStats();
+
+// Write-ahead log: record the entities a mutation touched, then commit them
+// together. Cheaper than saveAllData() for a single change.
+struct User;
+struct Crop;
+struct Order;
+struct TransportRequest;
+struct StorageRequest;
+struct Vehicle;
+struct StorageCenter;
+
+enum WalSyncPolicy {
+    WAL_SYNC_ALWAYS,   // fsync on every commit
+    WAL_SYNC_BATCHED,  // fsync at most every WAL_SYNC_INTERVAL_MS
+    WAL_SYNC_NEVER     // leave flushing to the OS
+};
+
+void setWalSyncPolicy(WalSyncPolicy policy);
+void walLogUser(User* user);
+void walLogCrop(Crop* crop);
+void walLogOrder(Order* order);
+void walLogTransportRequest(TransportRequest* req);
+void walLogStorageRequest(StorageRequest* req);
+void walLogVehicle(Vehicle* vehicle);
+void walLogStorageCenter(StorageCenter* center);
+void walCommit();
+
+// Replay data/wal.log on top of the loaded snapshots (called by loadAllData)
+void replayWAL();
+
 #endif // JSON_HANDLER_H
@@ -0,0 +1,127 @@
+/* ==================== CROP FILTER BENCHMARK ====================
+ * Times the crop listings in agriconnect_simple.cpp on a generated market:
+ * the type + budget search, a farmer's crop count and a farmer's listing.
+ * Each runs as the column scan over cropStore.byPrice the CLI uses and as
+ * the in-order walk of the price tree it replaced, and the two must select
+ * the same rows in the same order. A few crops are also added one at a time
+ * after the bulk load, the way "Add New Crop" does, and as one batch, to
+ * show what keeping byPrice sorted costs.
+ *
+ * Build and run from backend_cpp:
+ *   g++ -std=c++17 -O2 -pthread tests/crop_filter_bench.cpp -o crop_filter_bench
+ *   ./crop_filter_bench [crops]
+ */
+
+#define main cli_main
+#include "../agriconnect_simple.cpp"
+#undef main
+
+#include <chrono>
+
+const int FARMERS = 1000;
+const int BENCH_FARMER = 7;
+const int LATE_INSERTS = 1000;
+
+// The price tree walk the column scan replaced, kept here as the baseline
+template <typename Keep>
+void walkCropRows(Crop* root, Keep& keep, vector<int>& rows) {
+    if (root == nullptr) return;
+    walkCropRows(root->left, keep, rows);
+    if (keep(root->row)) rows.push_back(root->row);
+    walkCropRows(root->right, keep, rows);
+}
+
+template <typename Keep>
+vector<int> walkSelect(Keep keep) {
+    vector<int> rows;
+    walkCropRows(cropBSTRoot, keep, rows);
+    return rows;
+}
+
+Crop* makeCrop(int cropId, int farmerId, Symbol type, int price) {
+    Crop* crop = newNode<Crop>();
+    crop->cropId = cropId;
+    cropFarmerId(crop) = farmerId;
+    cropType(crop) = type;
+    cropQuantity(crop) = 100;
+    crop->quality = (Quality)intern("A");
+    cropPrice(crop) = price;
+    cropAvailable(crop) = (cropId % 5) != 0;
+    crop->left = crop->right = nullptr;
+    return crop;
+}
+
+template <typename F>
+double bestMs(F f) {
+    double best = 1e18;
+    for (int r = 0; r < 5; r++) {
+        auto start = chrono::steady_clock::now();
+        f();
+        best = min(best, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char* argv[]) {
+    int cropTotal = (argc > 1) ? atoi(argv[1]) : 1000000;
+    const char* typeNames[] = { "wheat", "rice", "mango", "cotton", "maize", "sugarcane", "potato", "onion" };
+    vector<Symbol> types;
+    for (const char* name : typeNames) types.push_back(intern(name));
+
+    unsigned seed = 12345;
+    vector<Crop*> crops;
+    crops.reserve(cropTotal);
+    for (int i = 0; i < cropTotal; i++) {
+        seed = seed * 1103515245 + 12345;
+        crops.push_back(makeCrop(i + 1, (seed >> 8) % FARMERS, types[(seed >> 4) % types.size()], (seed >> 12) % 500));
+    }
+    auto loadStart = chrono::steady_clock::now();
+    insertCrops(crops);
+    double loadMs = chrono::duration<double, milli>(chrono::steady_clock::now() - loadStart).count();
+
+    auto insertStart = chrono::steady_clock::now();
+    for (int i = 0; i < LATE_INSERTS; i++) {
+        seed = seed * 1103515245 + 12345;
+        insertCrop(makeCrop(cropTotal + i + 1, BENCH_FARMER, types[0], (seed >> 12) % 500));
+    }
+    double insertUs = chrono::duration<double, micro>(chrono::steady_clock::now() - insertStart).count() / LATE_INSERTS;
+    vector<Crop*> batch;
+    for (int i = 0; i < LATE_INSERTS; i++) {
+        seed = seed * 1103515245 + 12345;
+        batch.push_back(makeCrop(cropTotal + LATE_INSERTS + i + 1, BENCH_FARMER, types[1], (seed >> 12) % 500));
+    }
+    auto batchStart = chrono::steady_clock::now();
+    insertCrops(batch);
+    double batchMs = chrono::duration<double, milli>(chrono::steady_clock::now() - batchStart).count();
+
+    vector<bool> wheat(symbolCount());
+    wheat[types[0]] = true;
+    auto typeAndBudget = [&wheat](int row) {
+        return cropStore.available[row] != 0 && cropStore.pricePerKg[row] <= 200 && wheat[cropStore.cropType[row]];
+    };
+    auto ofFarmer = [](int row) { return cropStore.farmerId[row] == BENCH_FARMER; };
+
+    if (selectCropRows(typeAndBudget) != walkSelect(typeAndBudget) || selectCropRows(ofFarmer) != walkSelect(ofFarmer)) {
+        cerr << "FAIL column scan and tree walk disagree\n";
+        return 1;
+    }
+
+    size_t sink = 0;
+    double scanFilter = bestMs([&] { sink += selectCropRows(typeAndBudget).size(); });
+    double walkFilter = bestMs([&] { sink += walkSelect(typeAndBudget).size(); });
+    double scanCount = bestMs([&] { sink += countCropsForFarmer(BENCH_FARMER); });
+    double walkCount = bestMs([&] { sink += walkSelect(ofFarmer).size(); });
+    ostringstream listing;
+    streambuf* saved = cout.rdbuf(listing.rdbuf());
+    double scanList = bestMs([&] { listing.str(""); printFarmerCrops(BENCH_FARMER); });
+    cout.rdbuf(saved);
+
+    cout << fixed << setprecision(2);
+    cout << cropCount << " crops (bulk load " << loadMs << " ms, " << insertUs << " us per later insert, "
+         << LATE_INSERTS << "-crop batch " << batchMs << " ms)\n";
+    cout << "  type + budget filter  scan " << setw(8) << scanFilter << " ms  tree walk " << setw(8) << walkFilter << " ms\n";
+    cout << "  farmer crop count     scan " << setw(8) << scanCount << " ms  tree walk " << setw(8) << walkCount << " ms\n";
+    cout << "  farmer listing        scan " << setw(8) << scanList << " ms\n";
+    cout << "(checksum " << sink << ")\n";
+    return 0;
+}
@@ -0,0 +1,142 @@
+/* ==================== CROP PRICE INDEX BENCHMARK ====================
+ * Saves 10k, 100k and 1M crops with agriconnect_simple.cpp's own
+ * saveAllData into a scratch data/ folder, then times the startup reload
+ * (loadAllData: parse, bulk-build the AVL price tree, link, validate) and
+ * the all-crops listing, and prints the tree height. As the baseline, the
+ * loaded crops are then re-linked in file order through the plain BST
+ * insert the reload used before, which makes a tree as tall as the crop
+ * count; that is O(n^2), so it only runs up to a size limit.
+ *
+ * Build and run from backend_cpp (the scratch folder goes under /tmp):
+ *   g++ -std=c++17 -O2 -pthread tests/crop_index_bench.cpp -o crop_index_bench
+ *   ./crop_index_bench [largest crop count] [plain BST size limit]
+ */
+
+#define main cli_main
+#include "../agriconnect_simple.cpp"
+#undef main
+
+#include <chrono>
+
+const int FARMERS = 1000;
+
+// The unbalanced insert the reload used before, as a loop so a
+// list-shaped tree cannot overflow the stack
+Crop* insertPlainBST(Crop* root, Crop* newCrop) {
+    newCrop->left = newCrop->right = nullptr;
+    if (root == nullptr) return newCrop;
+    Crop* node = root;
+    while (true) {
+        Crop*& next = (cropPrice(newCrop) < cropPrice(node)) ? node->left : node->right;
+        if (next == nullptr) {
+            next = newCrop;
+            return root;
+        }
+        node = next;
+    }
+}
+
+int treeHeight(Crop* root) {
+    int height = 0;
+    vector<pair<Crop*, int>> stack;
+    if (root != nullptr) stack.push_back({ root, 1 });
+    while (!stack.empty()) {
+        pair<Crop*, int> top = stack.back();
+        stack.pop_back();
+        height = max(height, top.second);
+        if (top.first->left != nullptr) stack.push_back({ top.first->left, top.second + 1 });
+        if (top.first->right != nullptr) stack.push_back({ top.first->right, top.second + 1 });
+    }
+    return height;
+}
+
+void writeMarket(int cropTotal) {
+    clearAllData();
+    for (int i = 0; i < FARMERS; i++) {
+        User* user = newNode<User>();
+        user->userId = userIds.next();
+        user->username = "farmer" + to_string(i);
+        user->password = "p";
+        user->role = ROLE_FARMER;
+        user->active = true;
+        user->nextInList = nullptr;
+        insertUser(user);
+    }
+    const char* typeNames[] = { "wheat", "rice", "mango", "cotton" };
+    vector<Crop*> crops;
+    unsigned seed = 12345;
+    for (int i = 0; i < cropTotal; i++) {
+        seed = seed * 1103515245 + 12345;
+        Crop* crop = newNode<Crop>();
+        crop->cropId = cropIds.next();
+        cropFarmerId(crop) = 1 + (seed >> 8) % FARMERS;
+        cropType(crop) = intern(typeNames[(seed >> 4) % 4]);
+        cropQuantity(crop) = 100;
+        crop->quality = (Quality)intern("A");
+        cropPrice(crop) = (seed >> 12) % 500;
+        cropAvailable(crop) = true;
+        crop->dateAdded = crop->expiryDate = getCurrentDate();
+        crop->left = crop->right = nullptr;
+        crops.push_back(crop);
+    }
+    insertCrops(crops);
+    markAllDirty();
+    saveAllData();
+    flushPersistence();
+}
+
+double msSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int largest = (argc > 1) ? atoi(argv[1]) : 1000000;
+    int plainLimit = (argc > 2) ? atoi(argv[2]) : 30000;
+
+    char scratch[] = "/tmp/crop_index_bench_XXXXXX";
+    if (mkdtemp(scratch) == nullptr || chdir(scratch) != 0) {
+        cerr << "cannot create a scratch folder under /tmp\n";
+        return 1;
+    }
+    streambuf* console = cout.rdbuf();
+    ostringstream sink;
+    cout.rdbuf(sink.rdbuf());
+    ensureDataFolder();
+    cout.rdbuf(console);
+
+    cout << fixed << setprecision(1);
+    for (int crops = 10000; crops <= largest; crops *= 10) {
+        cout.rdbuf(sink.rdbuf());
+        writeMarket(crops);
+        sink.str("");
+        auto start = chrono::steady_clock::now();
+        loadAllData();
+        double loadMs = msSince(start);
+        int height = treeHeight(cropBSTRoot);
+        sink.str("");
+        start = chrono::steady_clock::now();
+        printAvailableCrops();
+        double listMs = msSince(start);
+        cout.rdbuf(console);
+        cout << "  " << setw(8) << crops << " crops: reload " << setw(8) << loadMs << " ms (AVL height " << height
+             << "), listing " << setw(7) << listMs << " ms";
+
+        if (crops <= plainLimit) {
+            vector<Crop*> inFileOrder;
+            for (int row : cropStore.byPrice) inFileOrder.push_back(cropStore.record[row]);
+            Crop* root = nullptr;
+            start = chrono::steady_clock::now();
+            for (Crop* crop : inFileOrder) root = insertPlainBST(root, crop);
+            double plainMs = msSince(start);
+            cout << "  |  plain BST link " << setw(8) << plainMs << " ms (height " << treeHeight(root) << ")";
+        }
+        cout << "\n";
+    }
+
+    cout.rdbuf(sink.rdbuf());
+    clearAllData();
+    cout.rdbuf(console);
+    error_code ec;
+    fs::remove_all(scratch, ec);
+    return 0;
+}
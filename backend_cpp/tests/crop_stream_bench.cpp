@@ -0,0 +1,206 @@
+/* ==================== CROP STREAM BENCHMARK ====================
+ * Starts integrated_server.cpp in this process (port 8080), grows the
+ * market to 10k, 100k and 1M crops, and at each size fetches GET /crops
+ * over a keep-alive connection. Prints time to first byte, time to the
+ * last chunk, and how far the process's resident set rose above where it
+ * stood before the request (sampled every millisecond; the client only
+ * counts bytes, so the rise is the server's). The same listing is then
+ * built the way the handler did before streaming, a stringstream copied
+ * into a body and again into the response, for comparison: there the
+ * first byte can only leave once the whole response exists.
+ *
+ * Build and run from backend_cpp (Linux; nothing else may hold port 8080):
+ *   g++ -std=c++17 -O2 -pthread tests/crop_stream_bench.cpp -o crop_stream_bench
+ *   ./crop_stream_bench [threads|epoll] [largest crop count]
+ */
+
+#define main integrated_server_main
+#include "../integrated_server.cpp"
+#undef main
+
+#include <chrono>
+
+const int FARMERS = 1000;
+
+long residentBytes() {
+    long pages = 0, resident = 0;
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (f != nullptr) {
+        if (fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+        fclose(f);
+    }
+    return resident * sysconf(_SC_PAGESIZE);
+}
+
+// Samples the resident set until stopped; peak is the highest reading
+struct RssSampler {
+    atomic<bool> running{true};
+    atomic<long> peak{0};
+    thread sampler;
+
+    RssSampler() : peak(residentBytes()) {
+        sampler = thread([this] {
+            while (running.load()) {
+                long now = residentBytes();
+                if (now > peak.load()) peak.store(now);
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+        });
+    }
+    long stop() {
+        running.store(false);
+        sampler.join();
+        long now = residentBytes();
+        return max(peak.load(), now);
+    }
+};
+
+int connectToServer() {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+struct FetchResult {
+    double firstByteMs;
+    double totalMs;
+    size_t bytes;
+    long rssRise;
+};
+
+// GET /crops, discarding the body as it arrives; done at the terminating chunk
+FetchResult fetchCrops(int fd) {
+    FetchResult result = { 0, 0, 0, 0 };
+    const string request = "GET /crops HTTP/1.1\r\nHost: localhost\r\n\r\n";
+    const string terminator = "\r\n0\r\n\r\n";
+    char chunk[65536];
+    string tail;
+    long before = residentBytes();
+    RssSampler rss;
+    auto start = chrono::steady_clock::now();
+    send(fd, request.data(), request.length(), MSG_NOSIGNAL);
+    while (true) {
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) break;
+        if (result.bytes == 0)
+            result.firstByteMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        result.bytes += n;
+        tail.append(chunk, n);
+        if (tail.length() > terminator.length()) tail.erase(0, tail.length() - terminator.length());
+        if (tail == terminator) break;
+    }
+    result.totalMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    result.rssRise = rss.stop() - before;
+    return result;
+}
+
+// The pre-streaming handler: whole listing into a stringstream, then a body copy, then the response
+FetchResult buildWholeResponse() {
+    FetchResult result = { 0, 0, 0, 0 };
+    long before = residentBytes();
+    RssSampler rss;
+    auto start = chrono::steady_clock::now();
+    {
+        SnapshotReadGuard guard;
+        CropSnapshot* crops = guard.load(cropSnapshot);
+        stringstream ss;
+        ss << "{\"crops\":[";
+        string piece;
+        bool first = true;
+        for (const shared_ptr<const CropPage>& page : crops->pages) {
+            for (const CropListing& listing : *page) {
+                piece.clear();
+                writeCropJSON(listing.crop, listing.farmer, piece);
+                if (!first) ss << ",";
+                ss << piece;
+                first = false;
+            }
+        }
+        ss << "]}";
+        string body = ss.str();
+        string response = buildHttpResponse(200, body, true);
+        result.bytes = response.length();
+        result.firstByteMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    }
+    result.totalMs = result.firstByteMs;
+    result.rssRise = rss.stop() - before;
+    return result;
+}
+
+void growCrops(int target) {
+    unique_lock<shared_mutex> lock(cropsLock);
+    unsigned seed = 12345 + cropCount;
+    while (cropCount < target) {
+        seed = seed * 1103515245 + 12345;
+        Crop* crop = new Crop;
+        crop->cropId = cropIds.next();
+        crop->farmerId = 1 + (seed >> 8) % FARMERS;
+        crop->cropType = ((seed >> 4) % 2) ? "Wheat" : "Rice";
+        crop->quantity = 100;
+        crop->quality = "A";
+        crop->pricePerKg = (seed >> 12) % 500;
+        crop->available = true;
+        crop->dateAdded = { 1, 1, 2026 };
+        crop->left = crop->right = nullptr;
+        crop->height = 1;
+        insertCrop(crop);
+    }
+    publishCrops();
+}
+
+int main(int argc, char* argv[]) {
+    string mode = (argc > 1) ? argv[1] : "epoll";
+    int largest = (argc > 2) ? atoi(argv[2]) : 1000000;
+
+    {
+        unique_lock<shared_mutex> lock(usersLock);
+        for (int i = 0; i < FARMERS; i++) {
+            User* user = new User;
+            user->userId = userIds.next();
+            user->username = "farmer" + to_string(i);
+            user->password = "p";
+            user->role = "farmer";
+            user->active = true;
+            user->nextInList = nullptr;
+            insertUser(user);
+        }
+        publishUsers();
+    }
+
+    string modeArg = "--mode=" + mode;
+    char* serverArgv[] = { (char*)"integrated_server", (char*)modeArg.c_str(), nullptr };
+    cout.setstate(ios::failbit);  // the banner
+    thread([&serverArgv] { integrated_server_main(2, serverArgv); }).detach();
+    int fd = -1;
+    for (int tries = 0; (fd = connectToServer()) < 0; tries++) {
+        if (tries == 500) {
+            cerr << "server did not start (is port " << PORT << " in use?)\n";
+            return 1;
+        }
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    cout.clear();
+
+    cout << fixed << setprecision(1);
+    cout << mode << " mode, GET /crops on one keep-alive connection\n";
+    for (int crops = 10000; crops <= largest; crops *= 10) {
+        growCrops(crops);
+        fetchCrops(fd);  // warm up: first touch of the connection's buffers
+        FetchResult streamed = fetchCrops(fd);
+        FetchResult whole = buildWholeResponse();
+        cout << "  " << setw(8) << crops << " crops, " << setw(6) << streamed.bytes / (1024.0 * 1024.0) << " MB"
+             << "  streamed: first byte " << setw(6) << streamed.firstByteMs << " ms, done " << setw(7) << streamed.totalMs
+             << " ms, RSS +" << setw(6) << streamed.rssRise / (1024.0 * 1024.0) << " MB"
+             << "  |  whole response: first byte " << setw(7) << whole.firstByteMs
+             << " ms, RSS +" << setw(6) << whole.rssRise / (1024.0 * 1024.0) << " MB\n";
+    }
+    cout.flush();
+    _exit(0);  // the server thread never returns
+}
@@ -0,0 +1,293 @@
+/* ==================== HTTP PARSER FUZZ / BENCHMARK ====================
+ * Drives the incremental request parser in integrated_server.cpp.
+ *
+ * Fuzz: random requests, built from a seed corpus and mutated, are fed once
+ * whole and once split into random recv-sized pieces (compacting the buffer
+ * between pieces, as the epoll workers do). Both feeds must yield the same
+ * requests and the same error status, and every view must point into the
+ * buffer. Exits 1 on the first mismatch and prints the input.
+ *
+ * Bench: times the parser against the find("\r\n\r\n") splitting it
+ * replaced, on the same pipelined traffic split into 4 KB reads.
+ *
+ * Build and run from backend_cpp:
+ *   g++ -std=c++17 -O1 -g -fsanitize=address,undefined -pthread tests/http_parser_fuzz.cpp -o http_parser_fuzz
+ *   ./http_parser_fuzz fuzz [iterations] [seed]
+ *   g++ -std=c++17 -O2 -pthread tests/http_parser_fuzz.cpp -o http_parser_bench
+ *   ./http_parser_bench bench [requests]
+ */
+
+#define main integrated_server_main
+#include "../integrated_server.cpp"
+#undef main
+
+#include <chrono>
+#include <random>
+
+struct ParsedRequest {
+    string method;
+    string target;
+    string version;
+    vector<pair<string, string>> headers;
+    string body;
+    bool keepAlive;
+
+    bool operator==(const ParsedRequest& o) const {
+        return method == o.method && target == o.target && version == o.version
+            && headers == o.headers && body == o.body && keepAlive == o.keepAlive;
+    }
+};
+
+struct ParseOutcome {
+    vector<ParsedRequest> requests;
+    int errorStatus;  // 0 if the input ended cleanly or mid-request
+};
+
+bool viewInside(string_view view, const string& buf) {
+    return view.empty() || (view.data() >= buf.data() && view.data() + view.length() <= buf.data() + buf.length());
+}
+
+// Take every request the parser has completed; false on a view outside buf
+bool drainRequests(HttpParser* p, const string& buf, ParseOutcome& outcome) {
+    HttpRequest req;
+    while (true) {
+        ParseState state = parseRequest(p, buf, &req);
+        if (state == PARSE_ERROR) {
+            outcome.errorStatus = p->errorStatus;
+            return true;
+        }
+        if (state != PARSE_DONE) return true;
+        if (!viewInside(req.method, buf) || !viewInside(req.target, buf) || !viewInside(req.body, buf)) return false;
+        ParsedRequest r;
+        r.method = string(req.method);
+        r.target = string(req.target);
+        r.version = string(req.version);
+        for (int i = 0; i < req.headerCount; i++) {
+            if (!viewInside(req.headerNames[i], buf) || !viewInside(req.headerValues[i], buf)) return false;
+            r.headers.push_back({ string(req.headerNames[i]), string(req.headerValues[i]) });
+        }
+        r.body = string(req.body);
+        r.keepAlive = req.keepAlive;
+        outcome.requests.push_back(r);
+        finishRequest(p);
+    }
+}
+
+// Feed input in pieces of the given sizes (the remainder goes last)
+bool parseInPieces(const string& input, const vector<size_t>& pieces, ParseOutcome& outcome) {
+    HttpParser parser;
+    initParser(&parser);
+    outcome.requests.clear();
+    outcome.errorStatus = 0;
+    string buf;
+    size_t pos = 0;
+    for (size_t i = 0; i <= pieces.size() && pos < input.length(); i++) {
+        size_t n = (i < pieces.size()) ? min(pieces[i], input.length() - pos) : input.length() - pos;
+        buf.append(input, pos, n);
+        pos += n;
+        if (!drainRequests(&parser, buf, outcome)) return false;
+        if (outcome.errorStatus != 0) return true;
+        compactBuffer(&parser, buf);
+    }
+    return true;
+}
+
+const char* SEEDS[] = {
+    "GET / HTTP/1.1\r\nHost: localhost\r\n\r\n",
+    "GET /crops?type=wheat&maxPrice=100 HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n",
+    "POST /register HTTP/1.1\r\nContent-Type: application/json\r\nContent-Length: 39\r\n\r\n{\"username\":\"ali\",\"password\":\"secret\"}",
+    "POST /login HTTP/1.0\r\nConnection: keep-alive\r\nContent-Length: 2\r\n\r\n{}",
+    "GET /crops/7 HTTP/1.1\nHost: bare-newlines\n\n",
+    "\r\n\r\nGET /status HTTP/1.1\r\n\r\n",
+    "OPTIONS /users HTTP/1.1\r\nOrigin: http://localhost\r\n\r\n",
+    "POST /register HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n0\r\n\r\n",
+    "GET / HTTP/2.0\r\n\r\n",
+    "POST / HTTP/1.1\r\nContent-Length: 12x\r\n\r\n",
+};
+const int SEED_COUNT = sizeof(SEEDS) / sizeof(SEEDS[0]);
+const char INTERESTING[] = " :\r\n\t0123456789/HTTP.-";
+
+string mutate(mt19937& rng, string s) {
+    int edits = 1 + rng() % 2;
+    for (int e = 0; e < edits; e++) {
+        size_t at = s.empty() ? 0 : rng() % (s.length() + 1);
+        switch (rng() % 12) {
+            case 0: if (!s.empty() && at < s.length()) s[at] = (char)(rng() % 256); break;
+            case 1: s.insert(at, 1, INTERESTING[rng() % (sizeof(INTERESTING) - 1)]); break;
+            case 2: if (at < s.length()) s.erase(at, 1 + rng() % 8); break;
+            case 3: if (at < s.length()) s.insert(at, s.substr(at, 1 + rng() % 16)); break;
+            case 4: s.insert(at, "Content-Length: " + to_string(rng() % 64) + "\r\n"); break;
+            case 5: s.insert(at, string(rng() % 4 ? 600 : 17000, 'a')); break;
+            default: {  // split or join lines, the cases a recv boundary is most likely to break
+                size_t nl = s.find('\n', at);
+                if (nl != string::npos) s.insert(nl, rng() % 2 ? "\r" : " x");
+            }
+        }
+    }
+    return s;
+}
+
+string randomInput(mt19937& rng) {
+    string input;
+    int requests = 1 + rng() % 3;  // pipelined
+    for (int i = 0; i < requests; i++) {
+        string seed = SEEDS[rng() % SEED_COUNT];
+        input += (rng() % 2 == 0) ? seed : mutate(rng, seed);
+    }
+    if (rng() % 8 == 0) {  // too many headers
+        size_t at = input.find('\n');
+        for (int i = 0; at != string::npos && i < MAX_HEADERS + 2; i++) input.insert(at + 1, "X-Pad: 1\r\n");
+    }
+    return input;
+}
+
+void printInput(const string& input) {
+    for (unsigned char c : input) {
+        if (c == '\r') cerr << "\\r";
+        else if (c == '\n') cerr << "\\n\n";
+        else if (c < 32 || c >= 127) cerr << "\\x" << hex << setw(2) << setfill('0') << (int)c << dec;
+        else cerr << c;
+    }
+    cerr << "\n";
+}
+
+int runFuzz(long iterations, unsigned seed) {
+    mt19937 rng(seed);
+    long completed = 0, errors = 0;
+    for (long it = 0; it < iterations; it++) {
+        string input = randomInput(rng);
+        ParseOutcome whole, split;
+        vector<size_t> pieces;
+        for (size_t total = 0; total < input.length(); ) {
+            size_t n = 1 + rng() % (rng() % 4 == 0 ? 3 : 512);
+            pieces.push_back(n);
+            total += n;
+        }
+        bool ok = parseInPieces(input, {}, whole) && parseInPieces(input, pieces, split);
+        if (!ok || whole.errorStatus != split.errorStatus || !(whole.requests == split.requests)) {
+            cerr << "MISMATCH at iteration " << it << " (seed " << seed << "): whole gave "
+                 << whole.requests.size() << " request(s), error " << whole.errorStatus << "; split gave "
+                 << split.requests.size() << " request(s), error " << split.errorStatus
+                 << (ok ? "" : "; a view pointed outside the buffer") << "\ninput:\n";
+            printInput(input);
+            return 1;
+        }
+        completed += whole.requests.size();
+        if (whole.errorStatus != 0) errors++;
+    }
+    cout << "fuzz: " << iterations << " inputs, " << completed << " requests parsed, "
+         << errors << " rejected, no mismatches\n";
+    return 0;
+}
+
+/* The splitter the parser replaced: rescans from the start of the pending
+ * buffer for the header end on every read and copies each request out. */
+string legacyFindHeader(const string& request, size_t headerEnd, const string& name) {
+    size_t lineStart = request.find("\r\n");
+    while (lineStart != string::npos && lineStart < headerEnd) {
+        lineStart += 2;
+        size_t lineEnd = request.find("\r\n", lineStart);
+        if (lineEnd == string::npos || lineEnd > headerEnd) lineEnd = headerEnd;
+        size_t colon = request.find(':', lineStart);
+        if (colon != string::npos && colon < lineEnd && colon - lineStart == name.length()) {
+            bool match = true;
+            for (size_t i = 0; i < name.length() && match; i++)
+                match = tolower((unsigned char)request[lineStart + i]) == tolower((unsigned char)name[i]);
+            if (match) {
+                size_t valueStart = colon + 1;
+                while (valueStart < lineEnd && request[valueStart] == ' ') valueStart++;
+                return request.substr(valueStart, lineEnd - valueStart);
+            }
+        }
+        lineStart = lineEnd;
+    }
+    return "";
+}
+
+size_t legacyRequestLength(const string& buf) {
+    size_t headerEnd = buf.find("\r\n\r\n");
+    if (headerEnd == string::npos) return 0;
+    size_t contentLength = strtoul(legacyFindHeader(buf, headerEnd, "Content-Length").c_str(), nullptr, 10);
+    size_t total = headerEnd + 4 + contentLength;
+    return buf.length() >= total ? total : 0;
+}
+
+size_t legacyConsume(const string& request) {
+    string method, path, body;
+    size_t pos = request.find(' ');
+    if (pos != string::npos) {
+        method = request.substr(0, pos);
+        size_t pos2 = request.find(' ', pos + 1);
+        if (pos2 != string::npos) path = request.substr(pos + 1, pos2 - pos - 1);
+    }
+    size_t bodyStart = request.find("\r\n\r\n");
+    if (bodyStart != string::npos) body = request.substr(bodyStart + 4);
+    return method.length() + path.length() + body.length();
+}
+
+int runBench(long requests) {
+    string traffic;
+    string bulk(64 * 1024, 'x');
+    for (long i = 0; i < requests; i++) {
+        if (i % 16 == 0) {
+            traffic += "POST /register HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/json\r\nContent-Length: "
+                + to_string(bulk.length()) + "\r\n\r\n" + bulk;
+        } else {
+            traffic += "GET /crops?type=wheat&maxPrice=" + to_string(i % 500)
+                + " HTTP/1.1\r\nHost: localhost\r\nUser-Agent: bench\r\nAccept: application/json\r\n\r\n";
+        }
+    }
+
+    auto start = chrono::steady_clock::now();
+    size_t legacyCount = 0, legacyBytes = 0;
+    string pending;
+    for (size_t pos = 0; pos < traffic.length(); pos += BUFFER_SIZE) {
+        pending.append(traffic, pos, BUFFER_SIZE);
+        size_t len;
+        while ((len = legacyRequestLength(pending)) > 0) {
+            string request = pending.substr(0, len);
+            pending.erase(0, len);
+            legacyBytes += legacyConsume(request);
+            legacyCount++;
+        }
+    }
+    double legacyMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    size_t parsedCount = 0, parsedBytes = 0;
+    HttpParser parser;
+    initParser(&parser);
+    string buf;
+    HttpRequest req;
+    for (size_t pos = 0; pos < traffic.length(); pos += BUFFER_SIZE) {
+        buf.append(traffic, pos, BUFFER_SIZE);
+        while (parseRequest(&parser, buf, &req) == PARSE_DONE) {
+            parsedBytes += req.method.length() + req.target.length() + req.body.length();
+            parsedCount++;
+            finishRequest(&parser);
+        }
+        compactBuffer(&parser, buf);
+    }
+    double parsedMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+    double mb = traffic.length() / (1024.0 * 1024.0);
+    cout << fixed << setprecision(2);
+    cout << "bench: " << requests << " pipelined requests, " << mb << " MB in " << BUFFER_SIZE << "-byte reads\n";
+    cout << "  find(\"\\r\\n\\r\\n\") splitter: " << legacyMs << " ms (" << mb / (legacyMs / 1000) << " MB/s), "
+         << legacyCount << " requests\n";
+    cout << "  incremental parser:     " << parsedMs << " ms (" << mb / (parsedMs / 1000) << " MB/s), "
+         << parsedCount << " requests\n";
+    if (legacyCount != parsedCount || legacyBytes != parsedBytes) {
+        cerr << "bench: the two parsers disagree\n";
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    string mode = (argc > 1) ? argv[1] : "fuzz";
+    if (mode == "bench") return runBench((argc > 2) ? atol(argv[2]) : 20000);
+    long iterations = (argc > 2) ? atol(argv[2]) : 200000;
+    unsigned seed = (argc > 3) ? (unsigned)strtoul(argv[3], nullptr, 10) : (unsigned)time(nullptr);
+    return runFuzz(iterations, seed);
+}
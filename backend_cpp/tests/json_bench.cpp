@@ -0,0 +1,189 @@
+/* ==================== JSON TOKENIZER BENCHMARK ====================
+ * Times the single-pass tokenizer in integrated_server.cpp (parseJsonObject
+ * plus jsonString per field) against the per-key extractJsonValue scan it
+ * replaced, reading the fields /register and /login read. The old scan
+ * rebuilds the quoted key and rescans the body for every field, and stops at
+ * the first quote, so escaped strings come out wrong; the checks at the start
+ * pin what the tokenizer is expected to return. The CLI's json_handler.cpp
+ * had its own per-key scan, extractJSONValue, which skips escaped quotes and
+ * unescapes the value afterwards; it is timed as a second baseline.
+ *
+ * Build and run from backend_cpp:
+ *   g++ -std=c++17 -O2 -pthread tests/json_bench.cpp -o json_bench
+ *   ./json_bench [iterations]
+ */
+
+#define main integrated_server_main
+#include "../integrated_server.cpp"
+#undef main
+
+#include <chrono>
+
+// The lookup the tokenizer replaced, kept here as the baseline
+string extractJsonValue(string_view json, const string& key) {
+    size_t keyPos = json.find("\"" + key + "\"");
+    if (keyPos == string::npos) return "";
+
+    size_t colonPos = json.find(":", keyPos);
+    if (colonPos == string::npos) return "";
+
+    size_t valueStart = json.find("\"", colonPos);
+    if (valueStart == string::npos) return "";
+
+    size_t valueEnd = json.find("\"", valueStart + 1);
+    if (valueEnd == string::npos) return "";
+
+    return string(json.substr(valueStart + 1, valueEnd - valueStart - 1));
+}
+
+// The CLI's per-key scan from json_handler.cpp, kept here as the second baseline
+string unescapeJSON(const string& str) {
+    string result;
+    for (size_t i = 0; i < str.length(); i++) {
+        if (str[i] == '\\' && i + 1 < str.length()) {
+            switch (str[i + 1]) {
+                case '"': result += '"'; i++; break;
+                case '\\': result += '\\'; i++; break;
+                case 'b': result += '\b'; i++; break;
+                case 'f': result += '\f'; i++; break;
+                case 'n': result += '\n'; i++; break;
+                case 'r': result += '\r'; i++; break;
+                case 't': result += '\t'; i++; break;
+                default: result += str[i];
+            }
+        } else {
+            result += str[i];
+        }
+    }
+    return result;
+}
+
+string extractJSONValue(const string& json, const string& key, bool isString = true) {
+    string searchKey = "\"" + key + "\":";
+    size_t keyPos = json.find(searchKey);
+    if (keyPos == string::npos) return "";
+
+    size_t startPos = keyPos + searchKey.length();
+    while (startPos < json.length() && (json[startPos] == ' ' || json[startPos] == '\n' || json[startPos] == '\t'))
+        startPos++;
+
+    if (isString) {
+        if (json[startPos] != '"') return "";
+        startPos++;
+        size_t endPos = startPos;
+        while (endPos < json.length() && json[endPos] != '"') {
+            if (json[endPos] == '\\') endPos++;
+            endPos++;
+        }
+        return unescapeJSON(json.substr(startPos, endPos - startPos));
+    } else {
+        size_t endPos = startPos;
+        while (endPos < json.length() && json[endPos] != ',' && json[endPos] != '}' && json[endPos] != ']')
+            endPos++;
+        return json.substr(startPos, endPos - startPos);
+    }
+}
+
+const char* REGISTER_FIELDS[] = { "username", "password", "role", "email", "phone" };
+const int REGISTER_FIELD_COUNT = 5;
+
+struct BenchBody {
+    const char* name;
+    string text;
+};
+
+int failures = 0;
+
+void expectField(const string& body, const char* key, const string& expected) {
+    JsonObject json;
+    string got = parseJsonObject(body, &json) ? jsonString(&json, key) : "<parse failed>";
+    if (got != expected) {
+        cerr << "FAIL " << key << " in " << body << ": got \"" << got << "\", expected \"" << expected << "\"\n";
+        failures++;
+    }
+}
+
+void expectRejected(const string& body) {
+    JsonObject json;
+    if (parseJsonObject(body, &json)) {
+        cerr << "FAIL accepted malformed body " << body << "\n";
+        failures++;
+    }
+}
+
+void runChecks() {
+    expectField("{\"username\":\"ali\",\"password\":\"p\"}", "username", "ali");
+    expectField("{\"note\":\"say \\\"hi\\\"\",\"username\":\"x\"}", "note", "say \"hi\"");
+    expectField("{\"note\":\"\\\"username\\\":\\\"evil\\\"\",\"username\":\"real\"}", "username", "real");
+    expectField("{\"path\":\"a\\\\b\\/c\\n\"}", "path", "a\\b/c\n");
+    expectField("{\"city\":\"Lahore \\u00e9\"}", "city", "Lahore \xc3\xa9");
+    expectField("{\"emoji\":\"\\ud83c\\udf3e\"}", "emoji", "\xf0\x9f\x8c\xbe");
+    expectField("{\"lone\":\"a\\ud800b\"}", "lone", "a\xef\xbf\xbd" "b");
+    expectField("{\"price\": 120, \"ok\": true, \"none\": null}", "price", "120");
+    expectField("{\"price\": 120, \"ok\": true, \"none\": null}", "ok", "true");
+    expectField("{\"price\": 120, \"ok\": true, \"none\": null}", "none", "");
+    expectField("{\"nested\":{\"username\":\"inner\"},\"username\":\"outer\"}", "username", "outer");
+    expectField(" { \"spaced\" : \"yes\" } ", "spaced", "yes");
+    expectRejected("{\"username\":\"unterminated}");
+    expectRejected("{\"a\":1,}");
+    expectRejected("[\"not\",\"an\",\"object\"]");
+    expectRejected("{\"a\" 1}");
+}
+
+template <typename Read>
+double timeReads(const BenchBody& body, long iterations, Read read, size_t& checksum) {
+    auto start = chrono::steady_clock::now();
+    for (long i = 0; i < iterations; i++) checksum += read(body.text);
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+}
+
+int main(int argc, char* argv[]) {
+    long iterations = (argc > 1) ? atol(argv[1]) : 500000;
+
+    runChecks();
+    if (failures > 0) {
+        cerr << failures << " check(s) failed\n";
+        return 1;
+    }
+    cout << "checks passed\n";
+
+    string padding;
+    for (int i = 0; i < 24; i++) padding += "\"extra" + to_string(i) + "\":\"" + string(40, 'z') + "\",";
+    vector<BenchBody> bodies = {
+        { "register", "{\"username\":\"farmer_ali\",\"password\":\"s3cret\",\"role\":\"farmer\","
+                      "\"email\":\"ali@example.pk\",\"phone\":\"03001234567\"}" },
+        { "register, fields last", "{" + padding + "\"username\":\"farmer_ali\",\"password\":\"s3cret\","
+                                   "\"role\":\"farmer\",\"email\":\"ali@example.pk\",\"phone\":\"03001234567\"}" },
+        { "register, escaped", "{\"username\":\"\\u0639\\u0644\\u06cc\",\"password\":\"a\\\"b\\\\c\","
+                               "\"role\":\"buyer\",\"email\":\"x@y.pk\",\"phone\":\"\\/0300\"}" },
+    };
+
+    size_t checksum = 0;
+    cout << fixed << setprecision(1);
+    cout << "reading " << REGISTER_FIELD_COUNT << " fields, " << iterations << " iterations per body\n";
+    for (const BenchBody& body : bodies) {
+        double legacyNs = timeReads(body, iterations, [](const string& text) {
+            size_t n = 0;
+            for (int f = 0; f < REGISTER_FIELD_COUNT; f++) n += extractJsonValue(text, REGISTER_FIELDS[f]).length();
+            return n;
+        }, checksum);
+        double cliNs = timeReads(body, iterations, [](const string& text) {
+            size_t n = 0;
+            for (int f = 0; f < REGISTER_FIELD_COUNT; f++) n += extractJSONValue(text, REGISTER_FIELDS[f]).length();
+            return n;
+        }, checksum);
+        double tokenizerNs = timeReads(body, iterations, [](const string& text) {
+            JsonObject json;
+            parseJsonObject(text, &json);
+            size_t n = 0;
+            for (int f = 0; f < REGISTER_FIELD_COUNT; f++) n += jsonString(&json, REGISTER_FIELDS[f]).length();
+            return n;
+        }, checksum);
+        cout << "  " << left << setw(24) << body.name << right << " (" << setw(4) << body.text.length() << " bytes)"
+             << "  extractJsonValue " << setw(8) << legacyNs << " ns"
+             << "  extractJSONValue " << setw(8) << cliNs << " ns"
+             << "  tokenizer " << setw(8) << tokenizerNs << " ns\n";
+    }
+    cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,219 @@
+/* ==================== JSON LOADER BENCHMARK ====================
+ * Writes a crops.json of the requested size (1 GB by default) in the
+ * format saveAllData produces, then loads it two ways, each in its own
+ * forked process so peak RSS is the loader's alone: the streaming reader
+ * agriconnect_simple.cpp uses (parseJSONArray with setCropField, then the
+ * bulk tree build), and the loader it replaced, which read the whole file
+ * through a stringstream, cut each object out with find/rfind/substr and
+ * rescanned it with extractJSONValue once per field. Both must load the
+ * same crops in the same order. The old loader read "available" as false
+ * whenever it was the line's last value, so that field is not compared.
+ *
+ * Build and run from backend_cpp (the scratch file goes under /tmp):
+ *   g++ -std=c++17 -O2 -pthread tests/json_loader_bench.cpp -o json_loader_bench
+ *   ./json_loader_bench [size in MB]
+ */
+
+#define main cli_main
+#include "../agriconnect_simple.cpp"
+#undef main
+
+#include <chrono>
+#include <sys/resource.h>
+#include <sys/wait.h>
+
+/* ---- The loader the streaming reader replaced, kept here as the baseline ---- */
+
+string unescapeJSON(const string& str) {
+    string result;
+    for (size_t i = 0; i < str.length(); i++) {
+        if (str[i] == '\\' && i + 1 < str.length()) {
+            switch (str[i + 1]) {
+                case '"': result += '"'; i++; break;
+                case '\\': result += '\\'; i++; break;
+                case 'b': result += '\b'; i++; break;
+                case 'f': result += '\f'; i++; break;
+                case 'n': result += '\n'; i++; break;
+                case 'r': result += '\r'; i++; break;
+                case 't': result += '\t'; i++; break;
+                default: result += str[i];
+            }
+        } else {
+            result += str[i];
+        }
+    }
+    return result;
+}
+
+string extractJSONValue(const string& json, const string& key, bool isString = true) {
+    string searchKey = "\"" + key + "\":";
+    size_t keyPos = json.find(searchKey);
+    if (keyPos == string::npos) return "";
+
+    size_t startPos = keyPos + searchKey.length();
+    while (startPos < json.length() && (json[startPos] == ' ' || json[startPos] == '\n' || json[startPos] == '\t'))
+        startPos++;
+
+    if (isString) {
+        if (json[startPos] != '"') return "";
+        startPos++;
+        size_t endPos = startPos;
+        while (endPos < json.length() && json[endPos] != '"') {
+            if (json[endPos] == '\\') endPos++;
+            endPos++;
+        }
+        return unescapeJSON(json.substr(startPos, endPos - startPos));
+    } else {
+        size_t endPos = startPos;
+        while (endPos < json.length() && json[endPos] != ',' && json[endPos] != '}' && json[endPos] != ']')
+            endPos++;
+        return json.substr(startPos, endPos - startPos);
+    }
+}
+
+Crop* parseCropJSON(const string& obj) {
+    Crop* newCrop = newNode<Crop>();
+    newCrop->cropId = stoi(extractJSONValue(obj, "cropId", false));
+    cropFarmerId(newCrop) = stoi(extractJSONValue(obj, "farmerId", false));
+    cropType(newCrop) = intern(extractJSONValue(obj, "cropType", true));
+    cropQuantity(newCrop) = stoi(extractJSONValue(obj, "quantity", false));
+    newCrop->storageQuantity = stoi(extractJSONValue(obj, "storageQuantity", false));
+    newCrop->quality = (Quality)intern(extractJSONValue(obj, "quality", true));
+    cropPrice(newCrop) = stoi(extractJSONValue(obj, "pricePerKg", false));
+    cropAvailable(newCrop) = extractJSONValue(obj, "available", false) == "true";
+    newCrop->storageCenter = extractJSONValue(obj, "storageCenter", true);
+    newCrop->left = newCrop->right = nullptr;
+    newCrop->dateAdded = parseJSONDate(extractJSONValue(obj, "dateAdded", true));
+    newCrop->expiryDate = parseJSONDate(extractJSONValue(obj, "expiryDate", true));
+    return newCrop;
+}
+
+void loadCropsTheOldWay(const string& path) {
+    vector<Crop*> loaded;
+    ifstream file(path);
+    stringstream buffer;
+    buffer << file.rdbuf();
+    string json = buffer.str();
+    size_t pos = 0;
+    while ((pos = json.find("\"cropId\"", pos)) != string::npos) {
+        size_t objStart = json.rfind('{', pos);
+        size_t objEnd = json.find('}', pos);
+        if (objStart == string::npos || objEnd == string::npos) break;
+        loaded.push_back(parseCropJSON(json.substr(objStart, objEnd - objStart + 1)));
+        pos = objEnd + 1;
+    }
+    insertCrops(loaded);
+}
+
+/* ---- Harness ---- */
+
+void loadCropsStreaming(const string& path) {
+    ParsedFile<Crop> parsed = parseJSONArray<Crop>(path, setCropField);
+    insertCrops(parsed.items);
+}
+
+struct LoadResult {
+    double ms;
+    long peakRssKb;
+    long crops;
+    uint64_t checksum;
+};
+
+// Fields both loaders read the same way, in listing order
+uint64_t cropChecksum() {
+    uint64_t sum = 0;
+    for (int row : cropStore.byPrice) {
+        Crop* crop = cropStore.record[row];
+        sum = sum * 1000003 + (uint64_t)crop->cropId;
+        sum = sum * 1000003 + (uint64_t)(cropPrice(crop) * 31 + cropFarmerId(crop));
+        sum = sum * 1000003 + (uint64_t)(cropQuantity(crop) * 31 + cropType(crop));
+    }
+    return sum;
+}
+
+// Run one loader in a child process so its peak RSS is measured alone
+LoadResult runLoader(void (*load)(const string&), const string& path) {
+    LoadResult result = { 0, 0, 0, 0 };
+    int fds[2];
+    if (pipe(fds) != 0) return result;
+    pid_t child = fork();
+    if (child == 0) {
+        close(fds[0]);
+        auto start = chrono::steady_clock::now();
+        load(path);
+        result.ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        rusage usage;
+        getrusage(RUSAGE_SELF, &usage);
+        result.peakRssKb = usage.ru_maxrss;
+        result.crops = cropCount;
+        result.checksum = cropChecksum();
+        if (write(fds[1], &result, sizeof(result)) != (ssize_t)sizeof(result)) _exit(1);
+        _exit(0);
+    }
+    close(fds[1]);
+    if (read(fds[0], &result, sizeof(result)) != (ssize_t)sizeof(result)) result.crops = -1;
+    close(fds[0]);
+    waitpid(child, nullptr, 0);
+    return result;
+}
+
+// A price-ordered crops.json of at least targetBytes, written like saveAllData writes it
+long writeCropsFile(const string& path, long long targetBytes) {
+    const char* typeNames[] = { "wheat", "rice", "mango", "cotton" };
+    ofstream file(path, ios::binary);
+    Crop* crop = newNode<Crop>();
+    crop->storageQuantity = 0;
+    crop->quality = (Quality)intern("A");
+    crop->dateAdded = crop->expiryDate = getCurrentDate();
+    crop->storageCenter = "";
+    cropQuantity(crop) = 100;
+    unsigned seed = 12345;
+    long count = 0;
+    file << "[\n";
+    while ((long long)file.tellp() < targetBytes) {
+        seed = seed * 1103515245 + 12345;
+        if (count > 0) file << ",\n";
+        crop->cropId = (int)count + 1;
+        cropFarmerId(crop) = 1 + (seed >> 8) % 1000;
+        cropType(crop) = intern(typeNames[(seed >> 4) % 4]);
+        cropPrice(crop) = (int)(count / 4096);
+        cropAvailable(crop) = (seed >> 12) % 4 != 0;
+        JsonObjectWriter w(file, true);
+        writeCropFields(w, crop);
+        w.end();
+        count++;
+    }
+    file << "\n]\n";
+    deleteNode(crop);
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    long long sizeMb = (argc > 1) ? atoll(argv[1]) : 1024;
+
+    char scratch[] = "/tmp/json_loader_bench_XXXXXX";
+    if (mkdtemp(scratch) == nullptr) {
+        cerr << "cannot create a scratch folder under /tmp\n";
+        return 1;
+    }
+    string path = string(scratch) + "/crops.json";
+    auto start = chrono::steady_clock::now();
+    long written = writeCropsFile(path, sizeMb * 1024 * 1024);
+    double writeMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    error_code ec;
+    double fileMb = fs::file_size(path, ec) / (1024.0 * 1024.0);
+
+    cout << fixed << setprecision(1);
+    cout << "crops.json: " << fileMb << " MB, " << written << " crops (written in " << writeMs / 1000 << " s)\n";
+    LoadResult streaming = runLoader(loadCropsStreaming, path);
+    cout << "  streaming reader " << setw(8) << streaming.ms / 1000 << " s, peak RSS " << setw(7)
+         << streaming.peakRssKb / 1024.0 << " MB, " << streaming.crops << " crops\n";
+    LoadResult old = runLoader(loadCropsTheOldWay, path);
+    cout << "  old loader       " << setw(8) << old.ms / 1000 << " s, peak RSS " << setw(7)
+         << old.peakRssKb / 1024.0 << " MB, " << old.crops << " crops\n";
+    fs::remove_all(scratch, ec);
+
+    bool ok = streaming.crops == written && old.crops == written && streaming.checksum == old.checksum;
+    cout << (ok ? "both loaders read the same crops\n" : "FAIL loaders disagree\n");
+    return ok ? 0 : 1;
+}
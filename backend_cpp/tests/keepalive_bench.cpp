@@ -0,0 +1,197 @@
+/* ==================== KEEP-ALIVE BENCHMARK ====================
+ * Starts integrated_server.cpp in this process (port 8080) and replays the
+ * dashboard's page load, GET /crops, /users and /status back to back, from
+ * several client threads. Each page load is sent three ways: over one
+ * persistent connection per client, pipelined as a single write on that
+ * connection, and with Connection: close on a fresh connection per request,
+ * which is what every request cost before keep-alive. Prints requests/sec
+ * for each.
+ *
+ * Build and run from backend_cpp (Linux; nothing else may hold port 8080):
+ *   g++ -std=c++17 -O2 -pthread tests/keepalive_bench.cpp -o keepalive_bench
+ *   ./keepalive_bench [threads|epoll] [clients] [page loads per client]
+ */
+
+#define main integrated_server_main
+#include "../integrated_server.cpp"
+#undef main
+
+#include <chrono>
+
+const int SEED_USERS = 50;
+const int SEED_CROPS = 200;
+const char* PAGE_PATHS[] = { "/crops", "/users", "/status" };
+const int PAGE_REQUESTS = 3;
+
+int connectToServer() {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(PORT);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Read until buf holds at least `need` bytes; false on EOF or error
+bool fill(int fd, string& buf, size_t need) {
+    char chunk[16384];
+    while (buf.length() < need) {
+        ssize_t n = recv(fd, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        buf.append(chunk, n);
+    }
+    return true;
+}
+
+// Consume one response (Content-Length or chunked) from the front of buf
+bool readResponse(int fd, string& buf) {
+    size_t headEnd;
+    while ((headEnd = buf.find("\r\n\r\n")) == string::npos) {
+        if (!fill(fd, buf, buf.length() + 1)) return false;
+    }
+    string head = buf.substr(0, headEnd);
+    size_t pos = headEnd + 4;
+    size_t lengthAt = head.find("Content-Length: ");
+    if (lengthAt != string::npos) {
+        size_t length = strtoul(head.c_str() + lengthAt + 16, nullptr, 10);
+        if (!fill(fd, buf, pos + length)) return false;
+        buf.erase(0, pos + length);
+        return true;
+    }
+    while (true) {  // chunked: hex size line, data, CRLF; a zero size ends the body
+        size_t lineEnd;
+        while ((lineEnd = buf.find("\r\n", pos)) == string::npos) {
+            if (!fill(fd, buf, buf.length() + 1)) return false;
+        }
+        size_t size = strtoul(buf.c_str() + pos, nullptr, 16);
+        pos = lineEnd + 2 + size + 2;
+        if (!fill(fd, buf, pos)) return false;
+        if (size == 0) break;
+    }
+    buf.erase(0, pos);
+    return true;
+}
+
+string requestFor(const char* path, bool close) {
+    return string("GET ") + path + " HTTP/1.1\r\nHost: localhost\r\n" + (close ? "Connection: close\r\n" : "") + "\r\n";
+}
+
+enum ClientMode { PERSISTENT, PIPELINED, CONNECTION_PER_REQUEST };
+
+// One client's page loads; returns the number of requests answered
+long runClient(ClientMode mode, int pages) {
+    long answered = 0;
+    string buf;
+    int fd = (mode == CONNECTION_PER_REQUEST) ? -1 : connectToServer();
+    string pipelined;
+    for (int r = 0; r < PAGE_REQUESTS; r++) pipelined += requestFor(PAGE_PATHS[r], false);
+    for (int p = 0; p < pages; p++) {
+        if (mode == PIPELINED) {
+            send(fd, pipelined.data(), pipelined.length(), MSG_NOSIGNAL);
+            for (int r = 0; r < PAGE_REQUESTS; r++) answered += readResponse(fd, buf);
+            continue;
+        }
+        for (int r = 0; r < PAGE_REQUESTS; r++) {
+            if (mode == CONNECTION_PER_REQUEST) {
+                fd = connectToServer();
+                buf.clear();
+            }
+            string request = requestFor(PAGE_PATHS[r], mode == CONNECTION_PER_REQUEST);
+            send(fd, request.data(), request.length(), MSG_NOSIGNAL);
+            answered += readResponse(fd, buf);
+            if (mode == CONNECTION_PER_REQUEST) close(fd);
+        }
+    }
+    if (fd >= 0 && mode != CONNECTION_PER_REQUEST) close(fd);
+    return answered;
+}
+
+double requestsPerSecond(ClientMode mode, int clients, int pages, long& answered) {
+    atomic<long> total(0);
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (int c = 0; c < clients; c++) threads.emplace_back([&total, mode, pages] { total += runClient(mode, pages); });
+    for (thread& t : threads) t.join();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    answered = total.load();
+    return answered / seconds;
+}
+
+int main(int argc, char* argv[]) {
+    string mode = (argc > 1) ? argv[1] : "epoll";
+    int clients = (argc > 2) ? atoi(argv[2]) : 4;
+    int pages = (argc > 3) ? atoi(argv[3]) : 2000;
+
+    {
+        unique_lock<shared_mutex> lock(usersLock);
+        for (int i = 0; i < SEED_USERS; i++) {
+            User* user = new User;
+            user->userId = userIds.next();
+            user->username = "farmer" + to_string(i);
+            user->password = "p";
+            user->role = "farmer";
+            user->active = true;
+            user->nextInList = nullptr;
+            insertUser(user);
+        }
+        publishUsers();
+    }
+    {
+        unique_lock<shared_mutex> lock(cropsLock);
+        for (int i = 0; i < SEED_CROPS; i++) {
+            Crop* crop = new Crop;
+            crop->cropId = cropIds.next();
+            crop->farmerId = 1 + i % SEED_USERS;
+            crop->cropType = (i % 2) ? "Wheat" : "Rice";
+            crop->quantity = 100;
+            crop->quality = "A";
+            crop->pricePerKg = 20 + i % 80;
+            crop->available = true;
+            crop->dateAdded = { 1, 1, 2026 };
+            crop->left = crop->right = nullptr;
+            crop->height = 1;
+            insertCrop(crop);
+        }
+        publishCrops();
+    }
+
+    string modeArg = "--mode=" + mode;
+    char* serverArgv[] = { (char*)"integrated_server", (char*)modeArg.c_str(), nullptr };
+    cout.setstate(ios::failbit);  // the banner
+    thread([&serverArgv] { integrated_server_main(2, serverArgv); }).detach();
+    for (int tries = 0;; tries++) {
+        int fd = connectToServer();
+        if (fd >= 0) {
+            close(fd);
+            break;
+        }
+        if (tries == 500) {
+            cerr << "server did not start (is port " << PORT << " in use?)\n";
+            return 1;
+        }
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    cout.clear();
+
+    cout << fixed << setprecision(0);
+    cout << mode << " mode, " << clients << " clients x " << pages << " page loads of " << PAGE_REQUESTS << " requests\n";
+    const char* names[] = { "keep-alive", "keep-alive, pipelined", "connection per request" };
+    long expected = (long)clients * pages * PAGE_REQUESTS;
+    bool ok = true;
+    for (int m = PERSISTENT; m <= CONNECTION_PER_REQUEST; m++) {
+        long answered = 0;
+        double rate = requestsPerSecond((ClientMode)m, clients, pages, answered);
+        cout << "  " << left << setw(24) << names[m] << right << setw(9) << rate << " req/s";
+        if (answered != expected) {
+            cout << "  (" << answered << " of " << expected << " answered)";
+            ok = false;
+        }
+        cout << "\n";
+    }
+    cout.flush();
+    _exit(ok ? 0 : 1);  // the server thread never returns
+}
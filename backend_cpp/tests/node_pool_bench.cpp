@@ -0,0 +1,135 @@
+/* ==================== NODE POOL BENCHMARK ====================
+ * Builds the users and orders of a large market the way a load does (each
+ * node follows a short-lived copy of its JSON object text and gets its
+ * string fields assigned) twice: once with a bare new per node, as
+ * agriconnect_simple.cpp did before the node pools, and once through
+ * newNode(). Counts the heap allocations each build makes through a
+ * counting operator new, then times the list scans viewSystemStatistics
+ * does: every user by role and every order by paid/delivered.
+ *
+ * Build and run from backend_cpp:
+ *   g++ -std=c++17 -O2 -pthread tests/node_pool_bench.cpp -o node_pool_bench
+ *   ./node_pool_bench [users] [orders per user]
+ */
+
+#include <new>
+#include <cstdlib>
+#include <atomic>
+
+std::atomic<long long> heapAllocations(0);
+
+void* operator new(std::size_t size) {
+    heapAllocations++;
+    void* p = std::malloc(size ? size : 1);
+    if (p == nullptr) throw std::bad_alloc();
+    return p;  // the library's operator delete frees with free()
+}
+
+#define main cli_main
+#include "../agriconnect_simple.cpp"
+#undef main
+
+#include <chrono>
+
+struct Market {
+    User* users = nullptr;
+    Order* orders = nullptr;
+    long long allocations = 0;
+    long long nodeAllocations = 0;  // made inside newUser()/newOrder() alone
+    double buildMs = 0;
+};
+
+// One build; newUser/newOrder decide where nodes come from
+template <typename NewUser, typename NewOrder>
+Market buildMarket(int userTotal, int ordersPerUser, NewUser newUser, NewOrder newOrder) {
+    Market market;
+    long long before = heapAllocations.load();
+    auto start = chrono::steady_clock::now();
+    string objectText;
+    for (int i = 0; i < userTotal; i++) {
+        objectText = "{\"userId\": " + to_string(i + 1) + ", \"username\": \"market_user_" + to_string(i) + "\", "
+                     "\"password\": \"pass123\", \"role\": \"farmer\", \"active\": true}" + string(60, ' ');
+        long long mark = heapAllocations.load();
+        User* user = newUser();
+        market.nodeAllocations += heapAllocations.load() - mark;
+        user->userId = i + 1;
+        user->username = "market_user_" + to_string(i);
+        user->password = "pass123";
+        user->role = (i % 2) ? ROLE_FARMER : ROLE_BUYER;
+        user->active = true;
+        user->nextInList = market.users;
+        market.users = user;
+        for (int k = 0; k < ordersPerUser; k++) {
+            objectText = "{\"orderId\": " + to_string(i * ordersPerUser + k) + ", \"cropId\": 1, \"buyerId\": 2, "
+                         "\"farmerId\": 3, \"quantity\": 10, \"paid\": true}" + string(60, ' ');
+            mark = heapAllocations.load();
+            Order* order = newOrder();
+            market.nodeAllocations += heapAllocations.load() - mark;
+            order->orderId = i * ordersPerUser + k;
+            order->quantity = 10;
+            order->paid = (k % 2) != 0;
+            order->delivered = (k % 3) == 0;
+            order->next = market.orders;
+            market.orders = order;
+        }
+    }
+    market.buildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    market.allocations = heapAllocations.load() - before;
+    return market;
+}
+
+// Best of five passes over both lists; returns million nodes per second
+double scanRate(const Market& market, long long& checksum) {
+    double best = 1e18;
+    long long nodes = 0;
+    for (int r = 0; r < 5; r++) {
+        nodes = 0;
+        auto start = chrono::steady_clock::now();
+        int farmers = 0, buyers = 0, paid = 0, delivered = 0;
+        for (User* u = market.users; u != nullptr; u = u->nextInList, nodes++) {
+            if (u->role == ROLE_FARMER) farmers++;
+            else if (u->role == ROLE_BUYER) buyers++;
+        }
+        for (Order* o = market.orders; o != nullptr; o = o->next, nodes++) {
+            if (o->paid) paid++;
+            if (o->delivered) delivered++;
+        }
+        best = min(best, chrono::duration<double, milli>(chrono::steady_clock::now() - start).count());
+        checksum += farmers + buyers + paid + delivered;
+    }
+    return nodes / best / 1000.0;
+}
+
+int main(int argc, char* argv[]) {
+    int userTotal = (argc > 1) ? atoi(argv[1]) : 200000;
+    int ordersPerUser = (argc > 2) ? atoi(argv[2]) : 10;
+    long long nodes = (long long)userTotal * (1 + ordersPerUser);
+    long long checksum = 0;
+
+    Market bare = buildMarket(userTotal, ordersPerUser, [] { return new User(); }, [] { return new Order(); });
+    double bareScan = scanRate(bare, checksum);
+    for (User* u = bare.users; u != nullptr;) {
+        User* next = u->nextInList;
+        delete u;
+        u = next;
+    }
+    for (Order* o = bare.orders; o != nullptr;) {
+        Order* next = o->next;
+        delete o;
+        o = next;
+    }
+
+    Market pooled = buildMarket(userTotal, ordersPerUser, [] { return newNode<User>(); }, [] { return newNode<Order>(); });
+    double pooledScan = scanRate(pooled, checksum);
+    NodePoolStats pools = getNodePoolStats();
+
+    cout << fixed << setprecision(1);
+    cout << userTotal << " users, " << (long long)userTotal * ordersPerUser << " orders\n";
+    cout << "  bare new:   build " << setw(7) << bare.buildMs << " ms, " << setw(9) << bare.nodeAllocations
+         << " node allocations (" << bare.allocations << " in all), scan " << setw(5) << bareScan << " M nodes/s\n";
+    cout << "  node pools: build " << setw(7) << pooled.buildMs << " ms, " << setw(9) << pooled.nodeAllocations
+         << " node allocations (" << pooled.allocations << " in all), scan " << setw(5) << pooledScan << " M nodes/s\n";
+    cout << "  (" << nodes << " nodes in " << pools.slabs << " slabs; \"in all\" adds the object text and string fields;"
+         << " checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,156 @@
+/* ==================== ORDER INDEX BENCHMARK ====================
+ * Adds 10M orders from 100k buyers and 10k farmers through
+ * agriconnect_simple.cpp's addOrder, then times the lookups behind the
+ * per-user order screens through the order indexes (a buyer's orders, a
+ * farmer's pending requests, a crop's orders, one order by id) against the
+ * walk of the whole orderHead list each screen made before. A walk costs
+ * O(orders), so it is timed on a few queries only. Each index answer must
+ * list the same orders in the same order as the walk.
+ *
+ * Build and run from backend_cpp (needs about 1.5 GB RAM at 10M orders):
+ *   g++ -std=c++17 -O2 -pthread tests/order_index_bench.cpp -o order_index_bench
+ *   ./order_index_bench [orders] [buyers] [farmers] [walked queries]
+ */
+
+#define main cli_main
+#include "../agriconnect_simple.cpp"
+#undef main
+
+#include <chrono>
+#include <sys/resource.h>
+
+const int CROPS_PER_FARMER = 10;
+
+double msSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+long peakRssMb() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024;
+}
+
+// The scans the indexes replaced, kept here as the baseline
+void buyerOrdersInList(int buyerId, vector<int>& ids) {
+    for (Order* o = orderHead; o != nullptr; o = o->next)
+        if (o->buyerId == buyerId) ids.push_back(o->orderId);
+}
+
+void pendingOrdersInList(int farmerId, vector<int>& ids) {
+    for (Order* o = orderHead; o != nullptr; o = o->next)
+        if (o->farmerId == farmerId && !o->farmerApproved) ids.push_back(o->orderId);
+}
+
+void cropOrdersInList(int cropId, vector<int>& ids) {
+    for (Order* o = orderHead; o != nullptr; o = o->next)
+        if (o->cropId == cropId) ids.push_back(o->orderId);
+}
+
+void orderByIdInList(int orderId, vector<int>& ids) {
+    for (Order* o = orderHead; o != nullptr; o = o->next)
+        if (o->orderId == orderId) {
+            ids.push_back(o->orderId);
+            return;
+        }
+}
+
+void buyerOrdersIndexed(int buyerId, vector<int>& ids) {
+    for (Order* o = ordersForBuyer(buyerId); o != nullptr; o = o->nextByBuyer) ids.push_back(o->orderId);
+}
+
+void pendingOrdersIndexed(int farmerId, vector<int>& ids) {
+    for (Order* o = pendingOrdersForFarmer(farmerId); o != nullptr; o = o->nextPending) ids.push_back(o->orderId);
+}
+
+void cropOrdersIndexed(int cropId, vector<int>& ids) {
+    for (Order* o = ordersForCrop(cropId); o != nullptr; o = o->nextByCrop) ids.push_back(o->orderId);
+}
+
+void orderByIdIndexed(int orderId, vector<int>& ids) {
+    Order* o = findOrderById(orderId);
+    if (o != nullptr) ids.push_back(o->orderId);
+}
+
+struct View {
+    const char* name;
+    void (*indexed)(int, vector<int>&);
+    void (*walked)(int, vector<int>&);
+    int keys;  // queries draw keys from 1..keys
+};
+
+int main(int argc, char* argv[]) {
+    long orderTotal = (argc > 1) ? atol(argv[1]) : 10000000;
+    int buyers = (argc > 2) ? atoi(argv[2]) : 100000;
+    int farmers = (argc > 3) ? atoi(argv[3]) : 10000;
+    int walked = (argc > 4) ? atoi(argv[4]) : 5;
+    int crops = farmers * CROPS_PER_FARMER;
+    long rssBefore = peakRssMb();
+
+    auto start = chrono::steady_clock::now();
+    reserveOrders((int)orderTotal);
+    unsigned seed = 12345;
+    for (long i = 0; i < orderTotal; i++) {
+        seed = seed * 1103515245 + 12345;
+        Order* order = newNode<Order>();
+        order->orderId = orderIds.next();
+        order->cropId = 1 + (seed >> 8) % crops;
+        order->farmerId = 1 + (order->cropId - 1) / CROPS_PER_FARMER;
+        order->buyerId = 1 + (int)((seed >> 4) % buyers);
+        order->quantity = 10;
+        order->farmerApproved = (seed >> 20) % 3 != 0;
+        order->paid = order->farmerApproved && (seed >> 22) % 2 != 0;
+        order->delivered = false;
+        order->orderDate = order->approvalDate = order->paymentDate = { 1, 1, 2026 };
+        addOrder(order);
+    }
+    double addMs = msSince(start);
+
+    View views[] = {
+        { "buyer's orders       ", buyerOrdersIndexed, buyerOrdersInList, buyers },
+        { "farmer's pending     ", pendingOrdersIndexed, pendingOrdersInList, farmers },
+        { "crop's orders        ", cropOrdersIndexed, cropOrdersInList, crops },
+        { "order by id          ", orderByIdIndexed, orderByIdInList, (int)orderTotal },
+    };
+    const int INDEXED_QUERIES = 10000;
+
+    cout << fixed << setprecision(3);
+    cout << orderTotal << " orders, " << buyers << " buyers, " << farmers << " farmers, " << crops << " crops\n";
+    cout << "  addOrder " << setprecision(0) << addMs * 1e6 / orderTotal << " ns per order, peak RSS "
+         << peakRssMb() - rssBefore << " MB\n" << setprecision(3);
+    bool ok = true;
+    vector<int> indexedIds, walkedIds;
+    for (View& view : views) {
+        unsigned querySeed = 777;
+        size_t found = 0;
+        start = chrono::steady_clock::now();
+        for (int q = 0; q < INDEXED_QUERIES; q++) {
+            querySeed = querySeed * 1103515245 + 12345;
+            indexedIds.clear();
+            view.indexed(1 + (querySeed >> 4) % view.keys, indexedIds);
+            found += indexedIds.size();
+        }
+        double indexedUs = msSince(start) * 1000 / INDEXED_QUERIES;
+
+        querySeed = 777;
+        double walkedMs = 0;
+        for (int q = 0; q < walked; q++) {
+            querySeed = querySeed * 1103515245 + 12345;
+            int key = 1 + (querySeed >> 4) % view.keys;
+            walkedIds.clear();
+            start = chrono::steady_clock::now();
+            view.walked(key, walkedIds);
+            walkedMs += msSince(start);
+            indexedIds.clear();
+            view.indexed(key, indexedIds);
+            if (indexedIds != walkedIds) {
+                cerr << "FAIL " << view.name << "index and walk disagree on key " << key << "\n";
+                ok = false;
+            }
+        }
+        cout << "  " << view.name << "index " << setw(8) << indexedUs << " us, orderHead walk " << setw(9)
+             << walkedMs / max(walked, 1) << " ms per query  (" << found / INDEXED_QUERIES << " orders each)\n";
+    }
+    cout << (ok ? "indexes and walks list the same orders\n" : "FAIL indexes and walks disagree\n");
+    return ok ? 0 : 1;
+}
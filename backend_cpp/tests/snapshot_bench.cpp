@@ -0,0 +1,167 @@
+/* ==================== READ SNAPSHOT BENCHMARK ====================
+ * Measures the epoch-protected read snapshots in integrated_server.cpp
+ * through the route handlers, in-process. First the cost of publishing one
+ * new crop (POST /crops, which copies one page of the listing) against the
+ * full rebuild publishCrops does. Then, for 1 to 32 reader threads, reads
+ * per second with no writer, and reads and writes per second while one
+ * writer lists crops and another registers users. Readers alternate
+ * /status and /crops?maxPrice=5, which read the published snapshots and
+ * take no lock. The "locked" rows run the same readers holding the shared
+ * collection locks around each request, as the handlers did before the
+ * snapshots (and as a reader still does once every reader slot is taken),
+ * to show what that does to the writers.
+ *
+ * Reads can only scale with the cores the machine has; the core count is
+ * printed first.
+ *
+ * Build and run from backend_cpp:
+ *   g++ -std=c++17 -O2 -pthread tests/snapshot_bench.cpp -o snapshot_bench
+ *   ./snapshot_bench [crops] [seconds per run] [max readers]
+ */
+
+#define main integrated_server_main
+#include "../integrated_server.cpp"
+#undef main
+
+#include <chrono>
+
+const int SEED_FARMERS = 1000;
+
+// The whole body, including any streamed chunks
+size_t drainResponse(HttpResponse response) {
+    size_t bytes = response.body.length();
+    string piece;
+    while (response.stream != nullptr) {
+        piece.clear();
+        bool more = response.stream->produce(piece);
+        bytes += piece.length();
+        if (!more) break;
+    }
+    return bytes;
+}
+
+string addCropBody(int farmerId, int price) {
+    return "{\"farmerId\":" + to_string(farmerId) + ",\"type\":\"Wheat\",\"quantity\":10,\"price\":" + to_string(price) + "}";
+}
+
+size_t readOnce(int i) {
+    switch (i % 2) {
+        case 0: return drainResponse(dispatchRequest("GET", "/status", ""));
+        default: return drainResponse(dispatchRequest("GET", "/crops?maxPrice=5", ""));
+    }
+}
+
+struct MixResult {
+    double readsPerSec;
+    double cropWritesPerSec;
+    double registrationsPerSec;
+};
+
+MixResult runMix(int readers, bool withWriters, bool locked, double seconds) {
+    atomic<bool> stop(false);
+    atomic<long> reads(0), cropWrites(0), registrations(0);
+    static atomic<int> registrationSerial(0);
+    vector<thread> threads;
+    for (int r = 0; r < readers; r++) {
+        threads.emplace_back([&, r] {
+            long done = 0;
+            size_t bytes = 0;
+            for (int i = r; !stop.load(memory_order_relaxed); i++, done++) {
+                if (locked) {
+                    shared_lock<shared_mutex> crops(cropsLock);
+                    shared_lock<shared_mutex> users(usersLock);
+                    bytes += readOnce(i);
+                } else {
+                    bytes += readOnce(i);
+                }
+            }
+            reads += done + (long)(bytes == 0);
+        });
+    }
+    if (withWriters) {
+        threads.emplace_back([&] {
+            long done = 0;
+            for (int i = 0; !stop.load(memory_order_relaxed); i++, done++)
+                drainResponse(dispatchRequest("POST", "/crops", addCropBody(1 + i % SEED_FARMERS, 10 + i % 400)));
+            cropWrites += done;
+        });
+        threads.emplace_back([&] {
+            long done = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                string name = "reader_bench_" + to_string(registrationSerial++);
+                drainResponse(dispatchRequest("POST", "/register", "{\"username\":\"" + name + "\",\"password\":\"p\"}"));
+                done++;
+            }
+            registrations += done;
+        });
+    }
+    auto start = chrono::steady_clock::now();
+    this_thread::sleep_for(chrono::duration<double>(seconds));
+    stop.store(true);
+    for (thread& t : threads) t.join();
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return { reads.load() / elapsed, cropWrites.load() / elapsed, registrations.load() / elapsed };
+}
+
+int main(int argc, char* argv[]) {
+    int cropTotal = (argc > 1) ? atoi(argv[1]) : 100000;
+    double seconds = (argc > 2) ? atof(argv[2]) : 1.0;
+    int maxReaders = (argc > 3) ? atoi(argv[3]) : 32;
+    registerRoutes();
+    cout.setstate(ios::failbit);  // handlers log every registration and crop
+
+    for (int i = 0; i < SEED_FARMERS; i++)
+        drainResponse(dispatchRequest("POST", "/register", "{\"username\":\"farmer" + to_string(i) +
+                                      "\",\"password\":\"p\",\"role\":\"farmer\"}"));
+    {
+        unique_lock<shared_mutex> lock(cropsLock);
+        unsigned seed = 12345;
+        for (int i = 0; i < cropTotal; i++) {
+            seed = seed * 1103515245 + 12345;
+            Crop* crop = new Crop;
+            crop->cropId = cropIds.next();
+            crop->farmerId = 1 + (seed >> 8) % SEED_FARMERS;
+            crop->cropType = ((seed >> 4) % 2) ? "Wheat" : "Rice";
+            crop->quantity = 100;
+            crop->quality = "A";
+            crop->pricePerKg = (seed >> 12) % 500;
+            crop->available = true;
+            crop->dateAdded = { 1, 1, 2026 };
+            crop->left = crop->right = nullptr;
+            crop->height = 1;
+            insertCrop(crop);
+        }
+        publishCrops();
+    }
+
+    const int PUBLISHES = 2000;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < PUBLISHES; i++)
+        drainResponse(dispatchRequest("POST", "/crops", addCropBody(1 + i % SEED_FARMERS, i % 500)));
+    double insertUs = chrono::duration<double, micro>(chrono::steady_clock::now() - start).count() / PUBLISHES;
+    start = chrono::steady_clock::now();
+    {
+        unique_lock<shared_mutex> lock(cropsLock);
+        publishCrops();
+    }
+    double rebuildMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    cout.clear();
+
+    cout << fixed << setprecision(0);
+    cout << thread::hardware_concurrency() << " core(s), " << cropCount << " crops\n";
+    cout << "  POST /crops with paged publish " << setprecision(1) << insertUs << " us per crop; full rebuild "
+         << rebuildMs << " ms\n" << setprecision(0);
+    cout << "  readers   reads/s (no writers)   reads/s   crop writes/s   registrations/s   (with writers)\n";
+    for (int readers = 1; readers <= maxReaders; readers *= 2) {
+        cout.setstate(ios::failbit);
+        MixResult alone = runMix(readers, false, false, seconds);
+        MixResult mixed = runMix(readers, true, false, seconds);
+        MixResult locked = runMix(readers, true, true, seconds);
+        cout.clear();
+        cout << "  " << setw(7) << readers << setw(22) << alone.readsPerSec << setw(10) << mixed.readsPerSec
+             << setw(16) << mixed.cropWritesPerSec << setw(18) << mixed.registrationsPerSec << "\n";
+        cout << "  " << setw(7) << "locked" << setw(22) << "" << setw(10) << locked.readsPerSec
+             << setw(16) << locked.cropWritesPerSec << setw(18) << locked.registrationsPerSec << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+/* ==================== SHARED STORE STRESS TEST ====================
+ * Hammers the reader-writer locked users and crops collections in
+ * integrated_server.cpp through the route handlers, the way concurrent
+ * connection threads do. Writers register users (some racing for the same
+ * name) and list crops through POST /crops; readers list users and crops,
+ * read /status, look crops up by id and log in. At the end every
+ * registration and every crop must be present exactly once, the duplicate
+ * name must have been taken once, and every crop listing a reader saw must
+ * have been in price order.
+ *
+ * Build and run from backend_cpp (ThreadSanitizer reports any data race):
+ *   g++ -std=c++17 -O1 -g -fsanitize=thread -pthread tests/store_stress.cpp -o store_stress
+ *   ./store_stress [iterations]
+ */
+
+#define main integrated_server_main
+#include "../integrated_server.cpp"
+#undef main
+
+const int WRITER_THREADS = 4;
+const int READER_THREADS = 4;
+const int SEED_CROPS = 200;
+
+atomic<long> unsortedListings(0);
+
+// The whole body, including any streamed chunks
+string drainResponse(HttpResponse response) {
+    string all = response.body;
+    if (response.stream) {
+        while (response.stream->produce(all)) {}
+    }
+    return all;
+}
+
+void checkPriceOrder(const string& listing) {
+    int last = -1;
+    for (size_t p = 0; (p = listing.find("\"price\":", p)) != string::npos; p++) {
+        int price = atoi(listing.c_str() + p + 8);
+        if (price < last) unsortedListings++;
+        last = price;
+    }
+}
+
+Crop* makeCrop(int cropId, int farmerId, const string& type, int price) {
+    Crop* crop = new Crop;
+    crop->cropId = cropId;
+    crop->farmerId = farmerId;
+    crop->cropType = type;
+    crop->quantity = 10;
+    crop->quality = "A";
+    crop->pricePerKg = price;
+    crop->available = true;
+    crop->dateAdded = { 1, 1, 2026 };
+    crop->left = crop->right = nullptr;
+    crop->height = 1;
+    return crop;
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? atoi(argv[1]) : 2000;
+    registerRoutes();
+    {
+        unique_lock<shared_mutex> lock(cropsLock);
+        // Farmer 5 registers during the run, so listings must pick the name up
+        for (int i = 0; i < SEED_CROPS; i++)
+            insertCrop(makeCrop(i + 1, (i % 3 == 0) ? 5 : 0, (i % 2) ? "Wheat" : "Rice", i % 50));
+        publishCrops();
+    }
+    cout.setstate(ios::failbit);  // handlers log every registration, login and crop
+    string grower = drainResponse(dispatchRequest("POST", "/register", "{\"username\":\"grower\",\"password\":\"p\"}"));
+    int growerId = atoi(grower.c_str() + grower.find("\"id\": ") + 6);
+
+    vector<thread> threads;
+    for (int w = 0; w < WRITER_THREADS; w++) {
+        threads.emplace_back([w, iterations] {
+            for (int i = 0; i < iterations; i++) {
+                string name = "u" + to_string(w) + "_" + to_string(i);
+                drainResponse(dispatchRequest("POST", "/register", "{\"username\":\"" + name + "\",\"password\":\"p\"}"));
+                if (i % 10 == 0)
+                    drainResponse(dispatchRequest("POST", "/register", "{\"username\":\"same\",\"password\":\"p\"}"));
+            }
+        });
+    }
+    threads.emplace_back([iterations, growerId] {
+        for (int i = 0; i < iterations / 4; i++) {
+            drainResponse(dispatchRequest("POST", "/crops", "{\"farmerId\":" + to_string(growerId) +
+                                          ",\"type\":\"Mango\",\"quantity\":10,\"price\":" + to_string(i % 60) + "}"));
+        }
+    });
+    for (int r = 0; r < READER_THREADS; r++) {
+        threads.emplace_back([iterations] {
+            for (int i = 0; i < iterations / 4; i++) {
+                drainResponse(dispatchRequest("GET", "/users", ""));
+                drainResponse(dispatchRequest("GET", "/status", ""));
+                checkPriceOrder(drainResponse(dispatchRequest("GET", "/crops", "")));
+                checkPriceOrder(drainResponse(dispatchRequest("GET", "/crops?type=wheat&maxPrice=30", "")));
+                drainResponse(dispatchRequest("GET", "/crops/" + to_string(1 + i % SEED_CROPS), ""));
+                drainResponse(dispatchRequest("POST", "/login", "{\"username\":\"u0_1\",\"password\":\"p\"}"));
+            }
+        });
+    }
+    for (thread& t : threads) t.join();
+    cout.clear();
+
+    int expectedUsers = WRITER_THREADS * iterations + 2;  // plus "same" and the grower
+    int sameCount = 0, listed = 0;
+    for (User* u = userListHead; u != nullptr; u = u->nextInList) sameCount += (u->username == "same");
+    string users = drainResponse(dispatchRequest("GET", "/users", ""));
+    for (size_t p = 0; (p = users.find("\"id\":", p)) != string::npos; p++) listed++;
+    int expectedCrops = SEED_CROPS + iterations / 4;
+    string crops = drainResponse(dispatchRequest("GET", "/crops", ""));
+    checkPriceOrder(crops);
+    int cropsListed = 0;
+    for (size_t p = 0; (p = crops.find("\"id\":", p)) != string::npos; p++) cropsListed++;
+
+    cout << "users " << userCount << " listed " << listed << " (expected " << expectedUsers << "), "
+         << "'same' registered " << sameCount << " time(s), crops " << cropCount << " (expected "
+         << expectedCrops << ") listed " << cropsListed << ", unsorted listings " << unsortedListings.load() << "\n";
+    bool ok = userCount == expectedUsers && listed == expectedUsers && sameCount == 1
+        && cropCount == expectedCrops && cropsListed == expectedCrops && unsortedListings.load() == 0;
+    cout << (ok ? "PASS\n" : "FAIL\n");
+    return ok ? 0 : 1;
+}
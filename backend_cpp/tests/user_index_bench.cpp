@@ -0,0 +1,118 @@
+/* ==================== USER ID INDEX BENCHMARK ====================
+ * Loads 100k users and 1M crops into integrated_server.cpp and times the
+ * farmer lookup every crop listing makes: findUserById through the id
+ * index, once per crop, against the walk of userListHead it replaced.
+ * The walk costs O(users) per crop, so it is timed on a sample of crops
+ * and scaled up. Also times publishCrops, which resolves every farmer,
+ * and a full GET /crops drained through dispatchRequest.
+ *
+ * Build and run from backend_cpp:
+ *   g++ -std=c++17 -O2 -pthread tests/user_index_bench.cpp -o user_index_bench
+ *   ./user_index_bench [users] [crops] [list walk sample]
+ */
+
+#define main integrated_server_main
+#include "../integrated_server.cpp"
+#undef main
+
+#include <chrono>
+
+// The lookup the index replaced, kept here as the baseline
+User* findUserByIdInList(int userId) {
+    for (User* curr = userListHead; curr != nullptr; curr = curr->nextInList) {
+        if (curr->userId == userId) return curr;
+    }
+    return nullptr;
+}
+
+double msSince(chrono::steady_clock::time_point start) {
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    int userTotal = (argc > 1) ? atoi(argv[1]) : 100000;
+    int cropTotal = (argc > 2) ? atoi(argv[2]) : 1000000;
+    int sample = (argc > 3) ? atoi(argv[3]) : 2000;
+    if (sample > cropTotal) sample = cropTotal;
+    registerRoutes();
+
+    auto start = chrono::steady_clock::now();
+    unique_lock<shared_mutex> users(usersLock);
+    for (int i = 0; i < userTotal; i++) {
+        User* user = new User;
+        user->userId = userIds.next();
+        user->username = "farmer" + to_string(i);
+        user->password = "p";
+        user->role = "farmer";
+        user->active = true;
+        user->nextInList = nullptr;
+        insertUser(user);
+    }
+    publishUsers();
+    users.unlock();
+    double usersMs = msSince(start);
+
+    start = chrono::steady_clock::now();
+    unique_lock<shared_mutex> crops(cropsLock);
+    vector<int> farmers;
+    farmers.reserve(cropTotal);
+    unsigned seed = 12345;
+    for (int i = 0; i < cropTotal; i++) {
+        seed = seed * 1103515245 + 12345;
+        Crop* crop = new Crop;
+        crop->cropId = cropIds.next();
+        crop->farmerId = 1 + (seed >> 8) % userTotal;
+        crop->cropType = ((seed >> 4) % 2) ? "Wheat" : "Rice";
+        crop->quantity = 100;
+        crop->quality = "A";
+        crop->pricePerKg = (seed >> 12) % 500;
+        crop->available = true;
+        crop->dateAdded = { 1, 1, 2026 };
+        crop->left = crop->right = nullptr;
+        crop->height = 1;
+        insertCrop(crop);
+        farmers.push_back(crop->farmerId);
+    }
+    double cropsMs = msSince(start);
+
+    size_t found = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < cropTotal; i++) found += findUserById(farmers[i]) != nullptr;
+    double indexMs = msSince(start);
+
+    size_t foundInList = 0;
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < sample; i++) foundInList += findUserByIdInList(farmers[i]) != nullptr;
+    double listMs = msSince(start) * cropTotal / sample;
+    for (int i = 0; i < sample; i++) {
+        if (findUserByIdInList(farmers[i]) != findUserById(farmers[i])) {
+            cerr << "FAIL index and list disagree on user " << farmers[i] << "\n";
+            return 1;
+        }
+    }
+
+    start = chrono::steady_clock::now();
+    publishCrops();
+    double publishMs = msSince(start);
+    crops.unlock();
+
+    start = chrono::steady_clock::now();
+    HttpResponse response = dispatchRequest("GET", "/crops", "");
+    size_t bytes = response.body.length();
+    string piece;
+    while (response.stream != nullptr) {
+        piece.clear();
+        bool more = response.stream->produce(piece);
+        bytes += piece.length();
+        if (!more) break;
+    }
+    double listingMs = msSince(start);
+
+    cout << fixed << setprecision(1);
+    cout << userTotal << " users (inserted in " << usersMs << " ms), " << cropTotal << " crops (" << cropsMs << " ms)\n";
+    cout << "  farmer lookup per crop, id index   " << setw(10) << indexMs << " ms  (" << found << " found)\n";
+    cout << "  farmer lookup per crop, list walk  " << setw(10) << listMs << " ms  (scaled from " << sample << " crops, " << foundInList << " found)\n";
+    cout << "  publishCrops                       " << setw(10) << publishMs << " ms\n";
+    cout << "  GET /crops, drained                " << setw(10) << listingMs << " ms  (" << bytes / (1024 * 1024) << " MB)\n";
+    return 0;
+}